@@ -0,0 +1,42 @@
+# ARM build of the weight and threshold kernels for instruction and
+# cycle measurements under QEMU (see host/arm_bench.c)
+#
+# the kernels are compiled with the same options the GFE local.mk uses
+# for SpiNNaker (spinnaker_tools.mk: ARM code, -Ofast, no FPU) and linked
+# with the spin1_api replacements in host/ against newlib (semihosting).
+# host/arm_cycles.py runs the binaries and reports the results.
+
+# Directory to create ARM binaries in (must include trailing slash)
+ARM_OUTPUT_DIR = ../binaries/arm/
+
+ARM_GP ?= arm-none-eabi
+ARM_CC = $(ARM_GP)-gcc
+ARM_OPT ?= -Ofast
+ARM_CFLAGS = -mthumb-interwork -march=armv5te -std=gnu99 \
+	$(ARM_OPT) -g -Wall -Ihost -I. -DAPPLICATION_NAME_HASH=0 \
+	-DHOST_SINGLE_THREAD
+ARM_LDFLAGS = --specs=rdimon.specs
+
+W_SOURCES = weight.c comms_w.c process_w.c init_w.c comms_tx.c activation.c
+T_SOURCES = threshold.c comms_t.c process_t.c init_t.c comms_tx.c activation.c
+
+HEADERS = $(wildcard *.h) $(wildcard host/*.h)
+
+ARM_SOURCES = host/arm_bench.c host/spin1_host.c
+
+all: $(ARM_OUTPUT_DIR)weight_bench.elf $(ARM_OUTPUT_DIR)threshold_bench.elf
+
+$(ARM_OUTPUT_DIR)weight_bench.elf: $(ARM_SOURCES) $(W_SOURCES) $(HEADERS)
+	mkdir -p $(ARM_OUTPUT_DIR)
+	$(ARM_CC) $(ARM_CFLAGS) -DARM_BENCH_WEIGHT $(ARM_LDFLAGS) -o $@ \
+		$(ARM_SOURCES) $(W_SOURCES) -lm
+
+$(ARM_OUTPUT_DIR)threshold_bench.elf: $(ARM_SOURCES) $(T_SOURCES) $(HEADERS)
+	mkdir -p $(ARM_OUTPUT_DIR)
+	$(ARM_CC) $(ARM_CFLAGS) -DARM_BENCH_THRESHOLD $(ARM_LDFLAGS) -o $@ \
+		$(ARM_SOURCES) $(T_SOURCES) -lm
+
+clean:
+	$(RM) -r $(ARM_OUTPUT_DIR)
+
+.PHONY: all clean
@@ -4,6 +4,7 @@
 // mlp
 #include "mlp_params.h"
 #include "mlp_types.h"
+#include "mlp_macros.h"
 #include "mlp_externs.h"
 
 #include "init_i.h"
@@ -26,8 +27,8 @@ void i_receivePacket (uint key, uint payload)
 #endif
 
   // queue packet - if space available
-  uint new_tail = (i_pkt_queue.tail + 1) % SPINN_INPUT_PQ_LEN;
-  if (new_tail == i_pkt_queue.head)
+  uint tail = i_pkt_queue.tail;
+  if ((tail - i_pkt_queue.head) > SPINN_INPUT_PQ_MASK)
   {
     // report queue full error
     stage_done (SPINN_QUEUE_FULL, 0);
@@ -35,9 +36,13 @@ void i_receivePacket (uint key, uint payload)
   else
   {
     // if not full enqueue packet,
-    i_pkt_queue.queue[i_pkt_queue.tail].key = key;
-    i_pkt_queue.queue[i_pkt_queue.tail].payload = payload;
-    i_pkt_queue.tail = new_tail;
+    i_pkt_queue.queue[tail & SPINN_INPUT_PQ_MASK].key = key;
+    i_pkt_queue.queue[tail & SPINN_INPUT_PQ_MASK].payload = payload;
+
+    // publish it only once written (the queue is read without
+    // disabling interrupts),
+    SPINN_BARRIER ();
+    i_pkt_queue.tail = tail + 1;
 
     // and schedule processing thread -- if not active already
     if (!i_active)
@@ -62,19 +67,36 @@ void i_processQueue (uint unused0, uint unused1)
   io_printf (IO_BUF, "i_process\n");
 #endif
 
-  // access queue with interrupts disabled,
-  uint cpsr = spin1_int_disable ();
-
   // process until queue empty,
-  while (i_pkt_queue.head != i_pkt_queue.tail)
+  while (TRUE)
   {
+    // check for packets -- interrupts are disabled only to go to sleep,
+    if (i_pkt_queue.head == i_pkt_queue.tail)
+    {
+      uint cpsr = spin1_int_disable ();
+
+      if (i_pkt_queue.head == i_pkt_queue.tail)
+      {
+        // flag going to sleep,
+        i_active = FALSE;
+
+        // and restore interrupts
+        spin1_mode_restore (cpsr);
+        return;
+      }
+
+      spin1_mode_restore (cpsr);
+    }
+
     // dequeue packet,
-    uint key = i_pkt_queue.queue[i_pkt_queue.head].key;
-    uint payload = i_pkt_queue.queue[i_pkt_queue.head].payload;
-    i_pkt_queue.head = (i_pkt_queue.head + 1) % SPINN_INPUT_PQ_LEN;
+    SPINN_BARRIER ();
+    packet_t * pkt = &i_pkt_queue.queue[i_pkt_queue.head & SPINN_INPUT_PQ_MASK];
+    uint key = pkt->key;
+    uint payload = pkt->payload;
 
-    // restore interrupts after queue access,
-    spin1_mode_restore (cpsr);
+    // and release its slot once read,
+    SPINN_BARRIER ();
+    i_pkt_queue.head++;
 
     uint pkt_type = key & SPINN_TYPE_MASK;
 
@@ -117,16 +139,7 @@ void i_processQueue (uint unused0, uint unused1)
       stage_done (SPINN_UNXPD_PKT, key);
     }
 #endif
-
-    // and access queue with interrupts disabled
-    cpsr = spin1_int_disable ();
   }
-
-  // flag going to sleep,
-  i_active = FALSE;
-
-  // and restore interrupts
-  spin1_mode_restore (cpsr);
 }
 // ------------------------------------------------------------------------
 
@@ -155,7 +168,7 @@ void i_stop_packet (uint key)
   if (if_thrds_pend == SPINN_THRD_STOP)
   {
     // if done initialise semaphore,
-    if_thrds_pend = SPINN_IF_THRDS;
+    if_thrds_pend = if_thrds_init;
 
     // restore interrupts after semaphore access,
     spin1_mode_restore (cpsr);
@@ -4,11 +4,13 @@
 // mlp
 #include "mlp_params.h"
 #include "mlp_types.h"
+#include "mlp_macros.h"
 #include "mlp_externs.h"
 
 #include "init_s.h"
 #include "comms_s.h"
 #include "process_s.h"
+#include "comms_tx.h"
 
 
 // ------------------------------------------------------------------------
@@ -16,7 +18,7 @@
 // ------------------------------------------------------------------------
 // ------------------------------------------------------------------------
 // enqueue received packet
-// (FORWARD, BACKPROP, ldsa, ldst, stop and net_stop types)
+// (FORWARD, BACKPROP, ldsa, ldst, ldsr, stop and net_stop types)
 // ------------------------------------------------------------------------
 void s_receivePacket (uint key, uint payload)
 {
@@ -25,8 +27,8 @@ void s_receivePacket (uint key, uint payload)
 #endif
 
   // queue packet - if space available
-  uint new_tail = (s_pkt_queue.tail + 1) % SPINN_SUM_PQ_LEN;
-  if (new_tail == s_pkt_queue.head)
+  uint tail = s_pkt_queue.tail;
+  if ((tail - s_pkt_queue.head) > SPINN_SUM_PQ_MASK)
   {
       // report queue full error
       stage_done (SPINN_QUEUE_FULL, 0);
@@ -34,9 +36,13 @@ void s_receivePacket (uint key, uint payload)
   else
   {
     // if not full enqueue packet,
-    s_pkt_queue.queue[s_pkt_queue.tail].key = key;
-    s_pkt_queue.queue[s_pkt_queue.tail].payload = payload;
-    s_pkt_queue.tail = new_tail;
+    s_pkt_queue.queue[tail & SPINN_SUM_PQ_MASK].key = key;
+    s_pkt_queue.queue[tail & SPINN_SUM_PQ_MASK].payload = payload;
+
+    // publish it only once written (the queue is read without
+    // disabling interrupts),
+    SPINN_BARRIER ();
+    s_pkt_queue.tail = tail + 1;
 
     // and schedule processing thread -- if not active already
     if (!s_active)
@@ -51,6 +57,10 @@ void s_receivePacket (uint key, uint payload)
 
 // ------------------------------------------------------------------------
 // process packet queue until empty
+// packets are taken in batches of up to SPINN_S_BATCH_LEN: FORWARD
+// partial nets are accumulated as they are dequeued, but the scoreboards
+// are updated (and complete nets sent) only once per unit and batch,
+// or before any other packet is processed
 // ------------------------------------------------------------------------
 void s_processQueue (uint unused0, uint unused1)
 {
@@ -61,85 +71,114 @@ void s_processQueue (uint unused0, uint unused1)
   io_printf (IO_BUF, "s_process\n");
 #endif
 
-  // access queue with interrupts disabled,
-  uint cpsr = spin1_int_disable ();
-
   // process until queue empty,
-  while (s_pkt_queue.head != s_pkt_queue.tail)
+  while (TRUE)
   {
-    // if not empty dequeue packet,
-    uint key = s_pkt_queue.queue[s_pkt_queue.head].key;
-    uint payload = s_pkt_queue.queue[s_pkt_queue.head].payload;
-    s_pkt_queue.head = (s_pkt_queue.head + 1) % SPINN_SUM_PQ_LEN;
+    // check for packets -- interrupts are disabled only to go to sleep,
+    if (s_pkt_queue.head == s_pkt_queue.tail)
+    {
+      uint cpsr = spin1_int_disable ();
 
-    // restore interrupts after queue access,
-    spin1_mode_restore (cpsr);
+      if (s_pkt_queue.head == s_pkt_queue.tail)
+      {
+        // flag going to sleep,
+        s_active = FALSE;
 
-    uint pkt_type = key & SPINN_TYPE_MASK;
+        // and restore interrupts
+        spin1_mode_restore (cpsr);
+        return;
+      }
 
-    // check if data packet,
-    if (pkt_type == SPINN_DATA_KEY)
+      spin1_mode_restore (cpsr);
+    }
+
+    // take a batch of the packets in the queue,
+    uint head = s_pkt_queue.head;
+    uint tail = s_pkt_queue.tail;
+    if ((tail - head) > SPINN_S_BATCH_LEN)
     {
-      // check packet phase and process accordingly
+      tail = head + SPINN_S_BATCH_LEN;
+    }
+    SPINN_BARRIER ();
+
+    while (head != tail)
+    {
+      // dequeue packet,
+      packet_t * pkt = &s_pkt_queue.queue[head & SPINN_SUM_PQ_MASK];
+      uint key = pkt->key;
+      uint payload = pkt->payload;
+
+      // and release its slot once read,
+      SPINN_BARRIER ();
+      s_pkt_queue.head = ++head;
+
+      uint pkt_type = key & SPINN_TYPE_MASK;
       uint ph = (key & SPINN_PHASE_MASK) >> SPINN_PHASE_SHIFT;
 
-      if (ph == SPINN_FORWARD)
+      // accumulate FORWARD phase partial nets,
+      if ((pkt_type == SPINN_DATA_KEY) && (ph == SPINN_FORWARD))
       {
-        // process FORWARD phase packet
-        sf_process (key, payload);
+        sf_batch_add (key, payload);
+        continue;
       }
-      else
+
+      // other packets must see the nets accumulated so far,
+      sf_batch_flush ();
+
+      // check if BACKPROP data packet,
+      if (pkt_type == SPINN_DATA_KEY)
       {
         // process BACKPROP phase packet
         sb_process (key, payload);
       }
-    }
 
-    // check for an LDS "accumulation" packet,
-    else if (pkt_type == SPINN_LDSA_KEY)
-    {
-      // process LDS "accumulation" packet
-      s_ldsa_packet (payload);
-    }
+      // check for an LDS "accumulation" packet,
+      else if (pkt_type == SPINN_LDSA_KEY)
+      {
+        // process LDS "accumulation" packet
+        s_ldsa_packet (payload);
+      }
 
-    // check for LDS "total" packet,
-    else if (pkt_type == SPINN_LDST_KEY)
-    {
-      // process LDS "total" packet
-      s_ldst_packet (payload);
-    }
+      // check for LDS "total" packet,
+      else if (pkt_type == SPINN_LDST_KEY)
+      {
+        // process LDS "total" packet
+        s_ldst_packet (payload);
+      }
 
-    // check if stop packet,
-    else if (pkt_type == SPINN_STOP_KEY)
-    {
-      // stop packet received
-      s_stop_packet (key);
-    }
+      // check for LDS "result" packet,
+      else if (pkt_type == SPINN_LDSR_KEY)
+      {
+        // relay LDS "result" packet
+        s_ldsr_packet (payload);
+      }
 
-    // check if network stop packet,
-    else if (pkt_type == SPINN_STPN_KEY)
-    {
-      // network stop packet received
-      s_net_stop_packet (key);
-    }
+      // check if stop packet,
+      else if (pkt_type == SPINN_STOP_KEY)
+      {
+        // stop packet received
+        s_stop_packet (key);
+      }
+
+      // check if network stop packet,
+      else if (pkt_type == SPINN_STPN_KEY)
+      {
+        // network stop packet received
+        s_net_stop_packet (key);
+      }
 
 #ifdef DEBUG
-    // report unknown packet type,
-    else
-    {
-      stage_done (SPINN_UNXPD_PKT, key);
-    }
+      // report unknown packet type,
+      else
+      {
+        stage_done (SPINN_UNXPD_PKT, key);
+      }
 #endif
+    }
 
-    // and access queue with interrupts disabled
-    cpsr = spin1_int_disable ();
+    // and update the scoreboards of the batch
+    sf_batch_flush ();
   }
-
-  // flag going to sleep,
-  s_active = FALSE;
-
-  // and restore interrupts
-  spin1_mode_restore (cpsr);
 }
 // ------------------------------------------------------------------------
 
@@ -168,7 +207,7 @@ void s_stop_packet (uint key)
   if (sf_thrds_pend == SPINN_THRD_STOP)
   {
     // if done initialise semaphore,
-    sf_thrds_pend = SPINN_SF_THRDS;
+    sf_thrds_pend = sf_thrds_init;
 
     // restore interrupts after semaphore access,
     spin1_mode_restore (cpsr);
@@ -232,6 +271,37 @@ void s_net_stop_packet (uint key)
 // ------------------------------------------------------------------------
 
 
+// ------------------------------------------------------------------------
+// send the link delta sum of the subtree rooted at this s core, once the
+// partial sums of its w cores and the totals of its children have
+// arrived: the root of the tree sends the final value (the result)
+// ------------------------------------------------------------------------
+static void s_lds_send (void)
+{
+  if (scfg.is_first_group)
+  {
+    // send the result to the w cores and to the child s cores,
+    tx_send (ldsrKey, s_lds_part, WITH_PAYLOAD);
+
+#ifdef DEBUG
+    pkt_sent++;
+    ldr_sent++;
+#endif
+  }
+  else
+  {
+    // or send the total to the parent s core
+    tx_send (ldstKey, s_lds_part, WITH_PAYLOAD);
+
+#ifdef DEBUG
+    pkt_sent++;
+    ldt_sent++;
+#endif
+  }
+}
+// ------------------------------------------------------------------------
+
+
 // ------------------------------------------------------------------------
 // process LDSA packet: accumulate the received partial link delta sums
 // ------------------------------------------------------------------------
@@ -250,16 +320,10 @@ void s_ldsa_packet (uint payload)
   // check whether all the partial sums have arrived
   if (s_ldsa_arrived == scfg.ldsa_expected)
   {
-    // send the result to the first s core
-    // to give a total across the whole network
-    if (scfg.is_first_group == 0)
+    // send the subtree total -- if the children totals have arrived
+    if (s_ldst_arrived == scfg.ldst_expected)
     {
-      while (!spin1_send_mc_packet (ldstKey, s_lds_part, WITH_PAYLOAD));
-
-#ifdef DEBUG
-      pkt_sent++;
-      ldt_sent++;
-#endif
+      s_lds_send ();
     }
 
     // access thread semaphore with interrupts disabled
@@ -310,16 +374,14 @@ void s_ldst_packet (uint payload)
   // increment the count of link delta sums arrived,
   s_ldst_arrived++;
 
-  // check whether all the partial sums have arrived
+  // check whether all the children totals have arrived
   if (s_ldst_arrived == scfg.ldst_expected)
   {
-    // send the final value of s_lds_part back to the w cores
-    while (!spin1_send_mc_packet (ldsrKey, s_lds_part, WITH_PAYLOAD));
-
-#ifdef DEBUG
-    pkt_sent++;
-    ldr_sent++;
-#endif
+    // send the subtree total -- if the partial sums have arrived
+    if (s_ldsa_arrived == scfg.ldsa_expected)
+    {
+      s_lds_send ();
+    }
 
     // access thread semaphore with interrupts disabled
     uint cpsr = spin1_int_disable ();
@@ -352,3 +414,55 @@ void s_ldst_packet (uint payload)
   }
 }
 // ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// process LDSR packet: relay the link delta sum result
+// to the w cores and to the child s cores
+// ------------------------------------------------------------------------
+void s_ldsr_packet (uint payload)
+{
+#ifdef DEBUG
+  ldr_recv++;
+#endif
+
+  tx_send (ldsrKey, payload, WITH_PAYLOAD);
+
+#ifdef DEBUG
+  pkt_sent++;
+  ldr_sent++;
+#endif
+
+  // access thread semaphore with interrupts disabled
+  uint cpsr = spin1_int_disable ();
+
+  // the result may arrive before the last BACKPROP tick waits for it,
+  s_ldsr_arrived = TRUE;
+
+#if defined(DEBUG) && defined(DEBUG_THRDS)
+  if (!(sb_thrds_pend & SPINN_THRD_LDSR))
+    wrng_cth++;
+#endif
+
+  // check if all other threads done
+  if (sb_thrds_pend == SPINN_THRD_LDSR)
+  {
+    // if done initialise semaphore
+    sb_thrds_pend = SPINN_SB_THRDS;
+
+    // restore interrupts after semaphore access,
+    spin1_mode_restore (cpsr);
+
+    // and advance tick
+    sb_advance_tick ();
+  }
+  else
+  {
+    // if not done report processing thread done,
+    sb_thrds_pend &= ~SPINN_THRD_LDSR;
+
+    // and restore interrupts after semaphore access
+    spin1_mode_restore (cpsr);
+  }
+}
+// ------------------------------------------------------------------------
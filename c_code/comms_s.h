@@ -9,5 +9,6 @@ void s_net_stop_packet (uint key);
 
 void s_ldsa_packet     (uint payload);
 void s_ldst_packet     (uint payload);
+void s_ldsr_packet     (uint payload);
 
 #endif
@@ -7,11 +7,13 @@
 // mlp
 #include "mlp_params.h"
 #include "mlp_types.h"
+#include "mlp_macros.h"
 #include "mlp_externs.h"
 
 #include "init_t.h"
 #include "comms_t.h"
 #include "process_t.h"
+#include "comms_tx.h"
 
 
 // ------------------------------------------------------------------------
@@ -39,10 +41,10 @@ void t_receivePacket (uint key, uint payload)
   }
 
   // FORWARD-phase packets are queued for background processing
-  uint new_tail = (t_pkt_queue.tail + 1) % SPINN_THLD_PQ_LEN;
+  uint tail = t_pkt_queue.tail;
 
   // check if space in packet queue,
-  if (new_tail == t_pkt_queue.head)
+  if ((tail - t_pkt_queue.head) > SPINN_THLD_PQ_MASK)
   {
     // report queue full error
     stage_done (SPINN_QUEUE_FULL, 0);
@@ -50,9 +52,13 @@ void t_receivePacket (uint key, uint payload)
   else
   {
     // if not full enqueue packet,
-    t_pkt_queue.queue[t_pkt_queue.tail].key = key;
-    t_pkt_queue.queue[t_pkt_queue.tail].payload = payload;
-    t_pkt_queue.tail = new_tail;
+    t_pkt_queue.queue[tail & SPINN_THLD_PQ_MASK].key = key;
+    t_pkt_queue.queue[tail & SPINN_THLD_PQ_MASK].payload = payload;
+
+    // publish it only once written (the queue is read without
+    // disabling interrupts),
+    SPINN_BARRIER ();
+    t_pkt_queue.tail = tail + 1;
 
     // and schedule FORWARD processing thread -- if not active already
     //TODO: do we need to check phase?
@@ -98,19 +104,36 @@ void t_processFWDQueue (uint unused0, uint unused1)
   (void) unused0;
   (void) unused1;
 
-  // access queue with interrupts disabled
-  uint cpsr = spin1_int_disable ();
-
-  // process until queue empty
-  while (t_pkt_queue.head != t_pkt_queue.tail)
+  // process until queue empty,
+  while (TRUE)
   {
+    // check for packets -- interrupts are disabled only to go to sleep,
+    if (t_pkt_queue.head == t_pkt_queue.tail)
+    {
+      uint cpsr = spin1_int_disable ();
+
+      if (t_pkt_queue.head == t_pkt_queue.tail)
+      {
+        // flag going to sleep,
+        tf_active = FALSE;
+
+        // and restore interrupts
+        spin1_mode_restore (cpsr);
+        return;
+      }
+
+      spin1_mode_restore (cpsr);
+    }
+
     // dequeue packet,
-    uint key = t_pkt_queue.queue[t_pkt_queue.head].key;
-    uint payload = (net_t) t_pkt_queue.queue[t_pkt_queue.head].payload;
-    t_pkt_queue.head = (t_pkt_queue.head + 1) % SPINN_THLD_PQ_LEN;
+    SPINN_BARRIER ();
+    packet_t * pkt = &t_pkt_queue.queue[t_pkt_queue.head & SPINN_THLD_PQ_MASK];
+    uint key = pkt->key;
+    uint payload = pkt->payload;
 
-    // restore interrupts after queue access,
-    spin1_mode_restore (cpsr);
+    // and release its slot once read,
+    SPINN_BARRIER ();
+    t_pkt_queue.head++;
 
     // check packet type,
     uint pkt_type = key & SPINN_TYPE_MASK;
@@ -124,7 +147,7 @@ void t_processFWDQueue (uint unused0, uint unused1)
     // process criterion packet,
     else if (pkt_type == SPINN_CRIT_KEY)
     {
-      t_criterion_packet (key);
+      t_criterion_packet (key, payload);
     }
 
     // process tick stop packet,
@@ -146,16 +169,7 @@ void t_processFWDQueue (uint unused0, uint unused1)
       stage_done (SPINN_UNXPD_PKT, key);
     }
 #endif
-
-    // and access queue with interrupts disabled
-    cpsr = spin1_int_disable ();
   }
-
-  // flag going to sleep,
-  tf_active = FALSE;
-
-  // and restore interrupts
-  spin1_mode_restore (cpsr);
 }
 // ------------------------------------------------------------------------
 
@@ -163,44 +177,56 @@ void t_processFWDQueue (uint unused0, uint unused1)
 // ------------------------------------------------------------------------
 // process a criterion packet
 // ------------------------------------------------------------------------
-void t_criterion_packet (uint key)
+void t_criterion_packet (uint key, uint payload)
 {
 #ifdef DEBUG
   crt_recv++;
 #endif
 
-  // partial criterion value arrived,
-  tf_crit_prev = key & SPINN_STPD_MASK;
+  // partial max criterion of the preceding slices of the group arrived,
+  if (key & SPINN_CRIT_MAX_OUT)
+  {
+    t_max_prev_output = (activation_t) payload;
+    t_max_prev_same = (key & SPINN_CRIT_SAME_MASK) != 0;
+    t_max_prev_evaluated = (key & SPINN_CRIT_MAX_EVAL) != 0;
+  }
+  else if (key & SPINN_CRIT_MAX_TGT)
+  {
+    t_max_prev_target = (activation_t) payload;
+  }
+  else
+  {
+    // or partial criterion value arrived,
+    tf_crit_prev = tf_crit_prev && (key & SPINN_STPD_MASK);
+  }
 
-  // access flag with interrupts disabled,
+  // access count with interrupts disabled,
   uint cpsr = spin1_int_disable ();
 
   // and check if updated criterion value can be forwarded
-  if (tf_crit_rdy)
+  if (--tf_crit_pend == 0)
   {
-    // initialise flag,
-    tf_crit_rdy = tf_init_crit;
+    // initialise count,
+    tf_crit_pend = tcfg.crit_expected + 1;
 
-    // restore interrupts after flag access,
+    // restore interrupts after count access,
     spin1_mode_restore (cpsr);
 
     // send stop packet,
     tf_send_stop ();
 
-    // and advance tick if last_output_group
+    // and advance tick if last_output_group or if event durations are fixed
     //NOTE: last output group does not get a tick stop packet
-    // so it's ready to advance tick
-    if (tcfg.is_last_output_group)
+    // so it's ready to advance tick, and with fixed event
+    // durations the other groups make the decision locally
+    if (tcfg.is_last_output_group || ncfg.fixed_ticks)
     {
       tf_advance_tick ();
     }
   }
   else
   {
-    // flag ready to forward criterion,
-    tf_crit_rdy = 1;
-
-    // and restore interrupts after flag access
+    // restore interrupts after count access
     spin1_mode_restore (cpsr);
   }
 }
@@ -231,7 +257,7 @@ void t_stop_packet (uint key)
   if (tf_thrds_pend == SPINN_THRD_STOP)
   {
     // initialise semaphore,
-    tf_thrds_pend = SPINN_TF_THRDS;
+    tf_thrds_pend = tf_thrds_init;
 
     // restore interrupts after semaphore access,
     spin1_mode_restore (cpsr);
@@ -281,6 +307,11 @@ void t_net_stop_packet (uint key)
       // finish stage and report no error
       spin1_schedule_callback (stage_done, SPINN_NO_ERROR, 0, SPINN_DONE_P);
     }
+    else if (tcfg.threshold_only)
+    {
+      // or start next example -- threshold-only groups receive no nets
+      spin1_schedule_callback (tf_process_tick, 0, 0, SPINN_TF_PROCESS_P);
+    }
   }
   else
   {
@@ -315,7 +346,8 @@ void t_backprop_packet (uint key, uint payload)
   tb_arrived++;
 
   // if all expected errors have arrived may move to next tick
-  if (tb_arrived == tcfg.num_units)
+  //NOTE: threshold-only groups receive partial errors from the w cores
+  if (tb_arrived == tcfg.bkp_expected)
   {
     // initialise arrival scoreboard for next tick,
     tb_arrived = 0;
@@ -359,8 +391,22 @@ void tf_send_stop (void)
   io_printf (IO_BUF, "tf_send_stop\n");
 #endif
 
-  // "aggregate" criteria,
+  // "aggregate" criteria -- the max criterion needs all the units
+  // of the group, so it is combined along the slices of split groups,
+  if (tcfg.criterion_function == SPINN_STOP_MAX)
+  {
+    tf_stop_crit = max_group_crit () && tf_stop_crit;
+  }
+
   tf_stop_crit = tf_stop_crit && tf_crit_prev;
+  tf_crit_prev = TRUE;
+
+  // slices that passed their max criterion on to the next one are done,
+  if (tcfg.crit_max_part)
+  {
+    tf_stop_crit = TRUE;
+    return;
+  }
 
   if (tcfg.is_last_output_group)
   {
@@ -378,11 +424,7 @@ void tf_send_stop (void)
   }
 
   // FORWARD aggregated criterion,
-  while (!spin1_send_mc_packet ((tf_stop_key | tf_stop_crit),
-                                 0,
-                                 NO_PAYLOAD
-                               )
-        );
+  tx_send ((tf_stop_key | tf_stop_crit), 0, NO_PAYLOAD);
 
 #ifdef DEBUG
   pkt_sent++;
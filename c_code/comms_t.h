@@ -5,7 +5,7 @@ void t_receivePacket   (uint key,     uint payload);
 void w_handleBKPPacket (uint key,     uint payload);
 void t_processFWDQueue (uint unused0, uint unused1);
 
-void t_criterion_packet (uint key);
+void t_criterion_packet (uint key, uint payload);
 void t_stop_packet      (uint key);
 void t_net_stop_packet  (uint key);
 
@@ -0,0 +1,176 @@
+// SpiNNaker API
+#include "spin1_api.h"
+
+// mlp
+#include "mlp_params.h"
+#include "mlp_types.h"
+
+#include "comms_tx.h"
+
+
+// ------------------------------------------------------------------------
+// outbound packet queue (common to all cores)
+// packets refused by the router interface are queued and sent later,
+// in order, by a background callback, so that the core can continue
+// computing while the fabric is congested
+// ------------------------------------------------------------------------
+// ------------------------------------------------------------------------
+// global variables
+// ------------------------------------------------------------------------
+static tx_packet_t tx_queue[SPINN_TX_QUEUE_LEN];
+static uint        tx_head;       // next packet to send (free-running)
+static uint        tx_tail;       // next free entry (free-running)
+static uchar       tx_active;     // drain callback scheduled?
+
+uint tx_refused_cnt;              // sends refused by the router interface
+uint tx_hwm;                      // outbound queue high-water mark
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// initialise stage statistics
+//NOTE: the queue is always empty at this point (see tx_flush)
+// ------------------------------------------------------------------------
+void tx_init (void)
+{
+  tx_refused_cnt = 0;
+  tx_hwm         = 0;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// send queued packets in order -- must be called with interrupts disabled
+// returns TRUE if the queue is empty
+// ------------------------------------------------------------------------
+static uint tx_send_queued (void)
+{
+  while (tx_head != tx_tail)
+  {
+    tx_packet_t * pkt = &tx_queue[tx_head & SPINN_TX_QUEUE_MASK];
+
+    if (!spin1_send_mc_packet (pkt->key, pkt->payload, pkt->load))
+    {
+      tx_refused_cnt++;
+      return (FALSE);
+    }
+
+    tx_head++;
+  }
+
+  return (TRUE);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// send a multicast packet without waiting for the router interface:
+// if it is busy, queue the packet and schedule the drain callback.
+// Packets are always sent in the order they were handed over.
+//NOTE: only waits (with interrupts enabled) if the queue is full
+// ------------------------------------------------------------------------
+void tx_send (uint key, uint payload, uint load)
+{
+  while (TRUE)
+  {
+    // access queue with interrupts disabled,
+    uint cpsr = spin1_int_disable ();
+
+    // send straight away if no packets are waiting,
+    if (tx_send_queued ())
+    {
+      if (spin1_send_mc_packet (key, payload, load))
+      {
+        spin1_mode_restore (cpsr);
+        return;
+      }
+
+      tx_refused_cnt++;
+    }
+
+    // otherwise queue packet -- if there is room,
+    uint depth = tx_tail - tx_head;
+    if (depth < SPINN_TX_QUEUE_LEN)
+    {
+      tx_packet_t * pkt = &tx_queue[tx_tail & SPINN_TX_QUEUE_MASK];
+      pkt->key     = key;
+      pkt->payload = payload;
+      pkt->load    = load;
+      tx_tail++;
+
+      // update high-water mark,
+      if (depth + 1 > tx_hwm)
+      {
+        tx_hwm = depth + 1;
+      }
+
+      // and schedule drain callback if not already scheduled
+      if (!tx_active)
+      {
+        tx_active = TRUE;
+        spin1_schedule_callback (tx_drain, 0, 0, SPINN_TX_P);
+      }
+
+      spin1_mode_restore (cpsr);
+      return;
+    }
+
+    // let the router interface make progress before trying again
+    spin1_mode_restore (cpsr);
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// background callback: send queued packets,
+// reschedule itself until the queue is empty
+//NOTE: this callback polls. spin1_send_mc_packet refuses a packet only when
+// the spin1 API's own outbound queue is full, and the API drains that queue
+// from the TX-empty interrupt, which it owns and does not pass on to the
+// application. The callback is queued with the lowest priority, so higher
+// priority callbacks run before each retry.
+// ------------------------------------------------------------------------
+void tx_drain (uint unused0, uint unused1)
+{
+  (void) unused0;
+  (void) unused1;
+
+  // access queue with interrupts disabled,
+  uint cpsr = spin1_int_disable ();
+
+  if (tx_send_queued ())
+  {
+    // flag going to sleep,
+    tx_active = FALSE;
+  }
+  else
+  {
+    // or try again later
+    spin1_schedule_callback (tx_drain, 0, 0, SPINN_TX_P);
+  }
+
+  // and restore interrupts
+  spin1_mode_restore (cpsr);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// wait until every queued packet has been sent (end of stage)
+//NOTE: a drain callback left scheduled finds the queue empty
+// ------------------------------------------------------------------------
+void tx_flush (void)
+{
+  uint empty = FALSE;
+
+  while (!empty)
+  {
+    uint cpsr = spin1_int_disable ();
+    empty = tx_send_queued ();
+    spin1_mode_restore (cpsr);
+  }
+
+  tx_active = FALSE;
+}
+// ------------------------------------------------------------------------
@@ -0,0 +1,12 @@
+#ifndef __COMMS_TX_H__
+#define __COMMS_TX_H__
+
+extern uint tx_refused_cnt;       // sends refused by the router interface
+extern uint tx_hwm;               // outbound queue high-water mark
+
+void tx_init  (void);
+void tx_send  (uint key, uint payload, uint load);
+void tx_drain (uint unused0, uint unused1);
+void tx_flush (void);
+
+#endif
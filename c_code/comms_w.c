@@ -5,6 +5,7 @@
 #include "mlp_params.h"
 #include "mlp_types.h"
 #include "mlp_externs.h"
+#include "mlp_macros.h"
 
 #include "init_w.h"
 #include "comms_w.h"
@@ -36,10 +37,10 @@ void w_receivePacket (uint key, uint payload)
   }
 
   // BACKPROP-phase packets are queued for background processing
-  uint new_tail = (w_pkt_queue.tail + 1) % SPINN_WEIGHT_PQ_LEN;
+  uint tail = w_pkt_queue.tail;
 
   // check if space in packet queue,
-  if (new_tail == w_pkt_queue.head)
+  if ((tail - w_pkt_queue.head) > SPINN_WEIGHT_PQ_MASK)
   {
     // report queue full error
     stage_done (SPINN_QUEUE_FULL, 0);
@@ -47,9 +48,13 @@ void w_receivePacket (uint key, uint payload)
   else
   {
     // if not full enqueue packet,
-    w_pkt_queue.queue[w_pkt_queue.tail].key = key;
-    w_pkt_queue.queue[w_pkt_queue.tail].payload = payload;
-    w_pkt_queue.tail = new_tail;
+    w_pkt_queue.queue[tail & SPINN_WEIGHT_PQ_MASK].key = key;
+    w_pkt_queue.queue[tail & SPINN_WEIGHT_PQ_MASK].payload = payload;
+
+    // publish it only once written (the queue is read without
+    // disabling interrupts),
+    SPINN_BARRIER ();
+    w_pkt_queue.tail = tail + 1;
 
     // and schedule BACKPROP processing thread
     if (!wb_active && (phase == SPINN_BACKPROP))
@@ -119,19 +124,37 @@ void w_processBKPQueue (uint unused0, uint unused1)
   io_printf (IO_BUF, "w_processBKPQueue\n");
 #endif
 
-  // access queue with interrupts disabled,
-  uint cpsr = spin1_int_disable ();
-
   // process until queue empty,
-  while (w_pkt_queue.head != w_pkt_queue.tail)
+  while (TRUE)
   {
+    // check for packets -- interrupts are disabled only to go to sleep,
+    if (w_pkt_queue.head == w_pkt_queue.tail)
+    {
+      uint cpsr = spin1_int_disable ();
+
+      if (w_pkt_queue.head == w_pkt_queue.tail)
+      {
+        // flag going to sleep,
+        wb_active = FALSE;
+
+        // and restore interrupts
+        spin1_mode_restore (cpsr);
+        return;
+      }
+
+      spin1_mode_restore (cpsr);
+    }
+
     // dequeue packet,
-    uint key = w_pkt_queue.queue[w_pkt_queue.head].key;
-    uint payload = w_pkt_queue.queue[w_pkt_queue.head].payload;
-    w_pkt_queue.head = (w_pkt_queue.head + 1) % SPINN_WEIGHT_PQ_LEN;
+    SPINN_BARRIER ();
+    packet_t * pkt =
+      &w_pkt_queue.queue[w_pkt_queue.head & SPINN_WEIGHT_PQ_MASK];
+    uint key = pkt->key;
+    uint payload = pkt->payload;
 
-    // restore interrupts after queue access,
-    spin1_mode_restore (cpsr);
+    // and release its slot once read,
+    SPINN_BARRIER ();
+    w_pkt_queue.head++;
 
     // check packet type,
     uint pkt_type = key & SPINN_TYPE_MASK;
@@ -155,16 +178,61 @@ void w_processBKPQueue (uint unused0, uint unused1)
       stage_done (SPINN_UNXPD_PKT, key);
     }
 #endif
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// store a received unit output and stream it into the partial nets
+// ------------------------------------------------------------------------
+static inline void w_forward_output (uint inx, activation_t output)
+{
+  // store received unit output,
+  w_outputs[wf_comms][inx] = output;
+
+  // stream it into the partial nets, if weights are ready,
+  if (wf_stream)
+  {
+    long_net_t * nets = w_nets[wf_comms];
+    uint const stride = SPINN_W_STRIDE (wcfg.num_rows + wcfg.bias_en,
+                                       wcfg.num_cols);
+
+    if (wcfg.weight_format == SPINN_WEIGHT_16)
+    {
+      // 16-bit weights need only 32 x 16-bit products
+      short_weight_t const * wts = &w_sweights[SPINN_W_INX (inx, 0, stride)];
+
+      for (uint j = 0; j < wcfg.num_cols; j++)
+      {
+        nets[j] += (SPINN_MULWB (output, wts[SPINN_W_INX (0, j, stride)])
+                     >> (SPINN_ACTIV_SHIFT + SPINN_SHORT_WEIGHT_SHIFT
+                         - SPINN_MULWB_SHIFT - SPINN_LONG_NET_SHIFT));
+      }
+    }
+    else
+    {
+      weight_t const * wts = &w_weights[SPINN_W_INX (inx, 0, stride)];
 
-    // and access queue with interrupts disabled
-    cpsr = spin1_int_disable ();
+      for (uint j = 0; j < wcfg.num_cols; j++)
+      {
+        nets[j] += (((long_net_t) output
+                      * (long_net_t) wts[SPINN_W_INX (0, j, stride)])
+                     >> (SPINN_ACTIV_SHIFT + SPINN_WEIGHT_SHIFT - SPINN_LONG_NET_SHIFT));
+      }
+    }
+  }
+  else
+  {
+    // or process all outputs when the tick is processed
+    w_nets_rdy[wf_comms] = FALSE;
   }
 
-  // flag going to sleep,
-  wb_active = FALSE;
+  // store output for use in BACKPROP phase,
+  store_output (inx);
 
-  // and restore interrupts
-  spin1_mode_restore (cpsr);
+  // update scoreboard,
+  wf_arrived++;
 }
 // ------------------------------------------------------------------------
 
@@ -179,25 +247,37 @@ void w_forward_packet (uint key, uint payload)
   if (phase == SPINN_BACKPROP)
     wrng_fph++;
 
-  uint blk = (key & SPINN_BLOCK_MASK) >> SPINN_BLOCK_SHIFT;
-  if (blk != wcfg.row_blk)
+#endif
+
+  // get output index: mask out phase and core data,
+  // and make it relative to the first row of the block
+  uint inx = (key & SPINN_OUTPUT_MASK) - wcfg.row_base;
+
+#ifdef DEBUG
+  if (inx >= wcfg.num_rows)
   {
     pkt_fwbk++;
     return;
   }
 #endif
 
-  // get output index: mask out phase, core and block data,
-  uint inx = key & SPINN_BLKOUT_MASK;
-
-  // store received unit output,
-  w_outputs[wf_comms][inx] = (activation_t) payload;
-
-  // store output for use in BACKPROP phase,
-  store_output (inx);
+  // packet carries a unit output as payload or, if packed,
+  // the outputs of a pair of units (the second one may be absent)
+  if (!ncfg.packed)
+  {
+    w_forward_output (inx, (activation_t) payload);
+  }
+  else
+  {
+    w_forward_output (inx, (activation_t) SPINN_PAIR_LO (payload)
+                             << (SPINN_ACTIV_SHIFT - SPINN_PACKED_ACTIV_SHIFT));
 
-  // update scoreboard,
-  wf_arrived++;
+    if ((inx + 1) < wcfg.num_rows)
+    {
+      w_forward_output (inx + 1, (activation_t) SPINN_PAIR_HI (payload)
+                             << (SPINN_ACTIV_SHIFT - SPINN_PACKED_ACTIV_SHIFT));
+    }
+  }
 
   // and check if all expected unit outputs have arrived
   if (wf_arrived == wcfg.num_rows)
@@ -224,8 +304,15 @@ void w_forward_packet (uint key, uint payload)
     }
     else
     {
-      // if not done report comms thread done
+      // if not done report comms thread done,
       wf_thrds_pend &= ~SPINN_THRD_COMS;
+
+      // and compute the next partial nets while
+      // waiting for the tick stop decision
+      if (wf_thrds_pend == SPINN_THRD_STOP)
+      {
+        spin1_schedule_callback (wf_speculate, 0, 0, SPINN_WF_SPEC_P);
+      }
     }
   }
 }
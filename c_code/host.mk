@@ -0,0 +1,60 @@
+# native (Linux) build of the four cores and the multicast-fabric simulator
+#
+# every core is built as a shared object against the spin1_api,
+# data_specification, simulation and recording replacements in host/.
+# mlp_host loads one private instance per machine vertex.
+#
+# HOST_OUTPUT_DIR and HOST_DEFS can be set on the command line
+# (see the host-dual target in Makefile).
+
+# Directory to create host binaries in (must include trailing slash)
+HOST_OUTPUT_DIR = ../binaries/host/
+
+HOST_CC ?= gcc
+HOST_DEFS ?=
+HOST_CFLAGS = -O2 -g $(HOST_DEFS) -std=gnu99 -Wall -Ihost -I. -DAPPLICATION_NAME_HASH=0
+
+W_SOURCES = weight.c comms_w.c process_w.c init_w.c comms_tx.c activation.c
+S_SOURCES = sum.c comms_s.c process_s.c init_s.c comms_tx.c activation.c
+I_SOURCES = input.c comms_i.c process_i.c init_i.c comms_tx.c activation.c
+T_SOURCES = threshold.c comms_t.c process_t.c init_t.c comms_tx.c activation.c
+
+HEADERS = $(wildcard *.h) $(wildcard host/*.h)
+
+SIM_SOURCES = host/mlp_host.c host/spin1_host.c
+BENCH_SOURCES = host/mlp_bench.c host/spin1_host.c
+
+all: $(HOST_OUTPUT_DIR)mlp_host \
+     $(HOST_OUTPUT_DIR)weight.so $(HOST_OUTPUT_DIR)sum.so \
+     $(HOST_OUTPUT_DIR)input.so $(HOST_OUTPUT_DIR)threshold.so \
+     $(HOST_OUTPUT_DIR)mlp_bench
+
+$(HOST_OUTPUT_DIR)mlp_host: $(SIM_SOURCES) $(HEADERS)
+	mkdir -p $(HOST_OUTPUT_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -pthread -rdynamic -o $@ $(SIM_SOURCES) -ldl
+
+# kernel microbenchmarks (see host/mlp_bench.c)
+$(HOST_OUTPUT_DIR)mlp_bench: $(BENCH_SOURCES) $(HEADERS)
+	mkdir -p $(HOST_OUTPUT_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -rdynamic -o $@ $(BENCH_SOURCES) -ldl
+
+$(HOST_OUTPUT_DIR)weight.so: $(W_SOURCES) $(HEADERS)
+	mkdir -p $(HOST_OUTPUT_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -fPIC -shared -o $@ $(W_SOURCES)
+
+$(HOST_OUTPUT_DIR)sum.so: $(S_SOURCES) $(HEADERS)
+	mkdir -p $(HOST_OUTPUT_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -fPIC -shared -o $@ $(S_SOURCES)
+
+$(HOST_OUTPUT_DIR)input.so: $(I_SOURCES) $(HEADERS)
+	mkdir -p $(HOST_OUTPUT_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -fPIC -shared -o $@ $(I_SOURCES)
+
+$(HOST_OUTPUT_DIR)threshold.so: $(T_SOURCES) $(HEADERS)
+	mkdir -p $(HOST_OUTPUT_DIR)
+	$(HOST_CC) $(HOST_CFLAGS) -fPIC -shared -o $@ $(T_SOURCES)
+
+clean:
+	$(RM) -r $(HOST_OUTPUT_DIR)
+
+.PHONY: all clean
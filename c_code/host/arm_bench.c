@@ -0,0 +1,412 @@
+// ARM instruction and cycle measurement harness for the MLP core kernels
+#include <stdlib.h>
+#include <string.h>
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+
+#include "mlp_params.h"
+#include "mlp_types.h"
+#include "mlp_externs.h"
+#include "mlp_macros.h"
+#include "mlp_host.h"
+
+#include "activation.h"
+#ifdef ARM_BENCH_WEIGHT
+#include "comms_w.h"
+#include "process_w.h"
+#endif
+#ifdef ARM_BENCH_THRESHOLD
+#include "process_t.h"
+#endif
+
+
+// ------------------------------------------------------------------------
+// built by arm_bench.mk with the sources of one core (ARM_BENCH_WEIGHT or
+// ARM_BENCH_THRESHOLD) for a bare-metal ARM target and run under QEMU
+// by host/arm_cycles.py, which counts the instructions executed between
+// arm_bench_start () and arm_bench_stop () and estimates ARM968 cycles.
+//
+// every kernel is called once to warm up and once measured, on square
+// blocks of 1, 2, 4, ... and MAX_BLK_UNITS units. Before every measurement
+// the harness prints a line "measure <kernel> <core> <size> <elements>",
+// so that the script can match measurements and kernels. The first
+// measurement (calibrate) is empty and gives the marker overhead.
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// harness constants
+// ------------------------------------------------------------------------
+// largest weight block (MLPConstants.MAX_BLK_UNITS in mlp_types.py)
+#define ARM_MAX_BLK_UNITS  48
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// simulator state expected by the spin1 shim
+// ------------------------------------------------------------------------
+HOST_THREAD_LOCAL host_core_t * host_cur = NULL;
+uint           host_verbose = FALSE;
+
+static host_core_t    arm_core = {.label = "arm"};
+
+static uint           size;           // current block size
+static volatile int   arm_sink;       // keeps results alive
+
+static net_t          arm_nets[ARM_MAX_BLK_UNITS];
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// spin1 shim support: packets and recordings are discarded
+// ------------------------------------------------------------------------
+uint host_route_packet (uint key, uint payload, uint load)
+{
+  (void) key;
+  (void) payload;
+  (void) load;
+
+  return (TRUE);
+}
+
+
+void host_buf_append (host_buf_t * buf, void const * data, uint size)
+{
+  (void) buf;
+  (void) data;
+  (void) size;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// measurement markers: QEMU traces record the execution of these
+// ------------------------------------------------------------------------
+void __attribute__ ((noinline)) arm_bench_start (void)
+{
+  __asm__ volatile ("");
+}
+
+
+void __attribute__ ((noinline)) arm_bench_stop (void)
+{
+  __asm__ volatile ("");
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// deterministic pseudo-random values in [lo, hi)
+// ------------------------------------------------------------------------
+static uint32_t arm_seed = 2463534242u;
+
+static int arm_rand (int lo, int hi)
+{
+  arm_seed ^= arm_seed << 13;
+  arm_seed ^= arm_seed >> 17;
+  arm_seed ^= arm_seed << 5;
+
+  return (lo + (int) (arm_seed % (uint32_t) (hi - lo)));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// warm up and measure one call of a kernel
+// ------------------------------------------------------------------------
+static void arm_measure (const char * name, const char * core, uint elements,
+                         void (* run) (void), void (* reset) (void))
+{
+  if (reset != NULL)
+  {
+    reset ();
+  }
+  run ();
+
+  if (reset != NULL)
+  {
+    reset ();
+  }
+
+  printf ("measure %s %s %u %u\n", name, core, size, elements);
+  fflush (stdout);
+
+  arm_bench_start ();
+  run ();
+  arm_bench_stop ();
+}
+
+
+static void arm_empty (void)
+{
+}
+
+
+// next block size: doubles, but always includes the largest block
+static uint arm_next_size (uint s)
+{
+  if ((s < ARM_MAX_BLK_UNITS) && ((2 * s) > ARM_MAX_BLK_UNITS))
+  {
+    return (ARM_MAX_BLK_UNITS);
+  }
+
+  return (2 * s);
+}
+// ------------------------------------------------------------------------
+
+
+#ifdef ARM_BENCH_WEIGHT
+// ------------------------------------------------------------------------
+// weight core kernels
+// ------------------------------------------------------------------------
+static weight_t       ref_weights[ARM_MAX_BLK_UNITS * ARM_MAX_BLK_UNITS];
+static w_wchange_t    ref_wchanges[ARM_MAX_BLK_UNITS * ARM_MAX_BLK_UNITS];
+
+
+// random block: weights in (-2, 2), outputs in [0, 1), deltas in (-1, 1)
+static void weight_init (void)
+{
+  // blocks are single arenas (as init_w.c)
+  uint arena = ARM_MAX_BLK_UNITS * ARM_MAX_BLK_UNITS;
+
+  w_weights     = malloc (arena * sizeof (weight_t));
+  w_weights_bp  = malloc (arena * sizeof (weight_t));
+  w_wchanges    = malloc (arena * sizeof (w_wchange_t));
+  w_link_deltas = malloc (arena * sizeof (w_delta_t));
+
+  w_errors     = calloc (ARM_MAX_BLK_UNITS, sizeof (error_t));
+  w_outputs[0] = malloc (ARM_MAX_BLK_UNITS * sizeof (activation_t));
+  w_outputs[1] = w_outputs[0];
+  w_nets[0]    = calloc (ARM_MAX_BLK_UNITS, sizeof (long_net_t));
+  w_nets[1]    = calloc (ARM_MAX_BLK_UNITS, sizeof (long_net_t));
+
+  // output history of tick 0 only
+  w_output_history = calloc (ARM_MAX_BLK_UNITS, sizeof (activation_t));
+
+  wcfg.learningRate = (short_fpreal) (0.1 * (1 << SPINN_SHORT_FPREAL_SHIFT));
+  wcfg.momentum     = (short_fpreal) (0.9 * (1 << SPINN_SHORT_FPREAL_SHIFT));
+  wcfg.weightDecay  = (short_fpreal) (0.001 * (1 << SPINN_SHORT_FPREAL_SHIFT));
+
+  ncfg.net_type = SPINN_NET_FEED_FWD;
+  xcfg.update_function = SPINN_STEEPEST_UPDATE;
+
+  wf_procs = 0;
+  wf_comms = 1;
+  wf_arrived = 0;
+  wb_arrived = 0;
+
+  // received outputs are streamed into the partial nets
+  wf_stream = TRUE;
+  w_nets_rdy[0] = TRUE;
+  w_nets_rdy[1] = TRUE;
+
+  // link delta sum above one exercises the square root
+  w_lds_final = 1000 << SPINN_LDS_SHIFT;
+
+  for (uint i = 0; i < ARM_MAX_BLK_UNITS; i++)
+  {
+    w_outputs[0][i] = arm_rand (0, SPINN_ACTIV_ONE);
+    arm_nets[i] = arm_rand (-(1 << SPINN_DELTA_SHIFT), 1 << SPINN_DELTA_SHIFT);
+  }
+
+  // every block size uses the start of the arenas
+  for (uint k = 0; k < arena; k++)
+  {
+    // zero weights are unconnected links: keep every link
+    weight_t w = arm_rand (-2 * SPINN_WEIGHT_ONE, 2 * SPINN_WEIGHT_ONE);
+    ref_weights[k] = (w == 0) ? 1 : w;
+    ref_wchanges[k] = arm_rand (-(1 << 16), 1 << 16);
+    w_link_deltas[k] = arm_rand (-(1 << SPINN_LONG_DELTA_SHIFT),
+                                 1 << SPINN_LONG_DELTA_SHIFT);
+  }
+}
+
+
+static void weight_reset (void)
+{
+  memcpy (w_weights, ref_weights, size * size * sizeof (weight_t));
+  memcpy (w_weights_bp, ref_weights, size * size * sizeof (weight_t));
+  memcpy (w_wchanges, ref_wchanges, size * size * sizeof (w_wchange_t));
+}
+
+
+// one call streams the outputs of a whole tick (num_rows packets)
+static void wfp_run (void)
+{
+  // other threads pending: do not advance tick
+  wf_thrds_pend = SPINN_WF_THRDS;
+
+  for (uint i = 0; i < size; i++)
+  {
+    w_forward_packet (i, (uint) w_outputs[0][i]);
+  }
+}
+
+
+// outputs were streamed: only the partial nets are sent
+static void wf_run (void)
+{
+  // other threads pending: do not advance tick
+  wf_thrds_pend = SPINN_WF_THRDS;
+
+  wf_process (0, 0);
+}
+
+
+// one call processes the deltas of a whole tick (num_cols packets)
+static void wb_run (void)
+{
+  // other threads pending: do not advance tick
+  wb_thrds_pend = SPINN_WB_THRDS | SPINN_THRD_COMS;
+
+  for (uint j = 0; j < size; j++)
+  {
+    wb_process (j, (uint) arm_nets[j]);
+  }
+}
+
+
+static void arm_bench_core (void)
+{
+  weight_init ();
+
+  for (size = 1; size <= ARM_MAX_BLK_UNITS; size = arm_next_size (size))
+  {
+    wcfg.num_rows = size;
+    wcfg.num_cols = size;
+
+    weight_reset ();
+
+    arm_measure ("w_forward_packet", "weight", size * size, wfp_run, NULL);
+    arm_measure ("wf_process", "weight", size, wf_run, NULL);
+    arm_measure ("wb_process", "weight", size * size, wb_run, NULL);
+    arm_measure ("steepest_update_weights", "weight", size * size,
+                 steepest_update_weights, weight_reset);
+    arm_measure ("momentum_update_weights", "weight", size * size,
+                 momentum_update_weights, weight_reset);
+    arm_measure ("dougsmomentum_update_weights", "weight", size * size,
+                 dougsmomentum_update_weights, weight_reset);
+    arm_measure ("w_refresh_weights", "weight", size * size,
+                 w_refresh_weights, NULL);
+  }
+}
+// ------------------------------------------------------------------------
+#endif
+
+
+#ifdef ARM_BENCH_THRESHOLD
+// ------------------------------------------------------------------------
+// threshold core kernels
+// ------------------------------------------------------------------------
+static activation_t   arm_outs[ARM_MAX_BLK_UNITS];
+
+
+// nets in (-16, 16), outputs in (0, 1), targets 0 or 1
+static void threshold_init (void)
+{
+  t_outputs      = calloc (ARM_MAX_BLK_UNITS, sizeof (activation_t));
+  t_nets         = calloc (ARM_MAX_BLK_UNITS, sizeof (net_t));
+  t_output_deriv = calloc (ARM_MAX_BLK_UNITS, sizeof (long_deriv_t));
+  tt             = calloc (ARM_MAX_BLK_UNITS, sizeof (activation_t));
+
+  tcfg.output_grp    = TRUE;
+  tcfg.num_out_procs = 1;
+  tcfg.procs_list[0] = SPINN_OUT_LOGISTIC;
+
+  // test mode: output derivatives are not stored
+  xcfg.training = FALSE;
+
+  t_it_idx = 0;
+
+  for (uint i = 0; i < ARM_MAX_BLK_UNITS; i++)
+  {
+    t_nets[i] = arm_rand (-(16 << SPINN_NET_SHIFT), 16 << SPINN_NET_SHIFT);
+    tt[i]     = (i & 1) ? SPINN_ACTIV_ONE : 0;
+
+    arm_nets[i] = t_nets[i];
+    arm_outs[i] = arm_rand (SPINN_ACTIV_ONE / 16,
+                            SPINN_ACTIV_ONE - SPINN_ACTIV_ONE / 16);
+  }
+}
+
+
+static void compute_out_run (void)
+{
+  for (uint i = 0; i < size; i++)
+  {
+    compute_out (i);
+  }
+}
+
+
+static void cross_entropy_reset (void)
+{
+  memcpy (t_outputs, arm_outs, size * sizeof (activation_t));
+}
+
+
+static void cross_entropy_run (void)
+{
+  for (uint i = 0; i < size; i++)
+  {
+    error_cross_entropy (i);
+  }
+}
+
+
+static void sigmoid_run (void)
+{
+  int s = 0;
+  for (uint i = 0; i < size; i++)
+  {
+    s += sigmoid (arm_nets[i]);
+  }
+  arm_sink = s;
+}
+
+
+static void inv_sigmoid_run (void)
+{
+  int s = 0;
+  for (uint i = 0; i < size; i++)
+  {
+    s += inv_sigmoid (arm_outs[i]);
+  }
+  arm_sink = s;
+}
+
+
+static void arm_bench_core (void)
+{
+  threshold_init ();
+
+  for (size = 1; size <= ARM_MAX_BLK_UNITS; size = arm_next_size (size))
+  {
+    tcfg.num_units = size;
+
+    arm_measure ("compute_out", "threshold", size, compute_out_run, NULL);
+    arm_measure ("error_cross_entropy", "threshold", size,
+                 cross_entropy_run, cross_entropy_reset);
+    arm_measure ("sigmoid", "activation", size, sigmoid_run, NULL);
+    arm_measure ("inv_sigmoid", "activation", size, inv_sigmoid_run, NULL);
+  }
+}
+// ------------------------------------------------------------------------
+#endif
+
+
+int main (void)
+{
+  host_cur = &arm_core;
+
+  // marker overhead,
+  size = 0;
+  arm_measure ("calibrate", "none", 0, arm_empty, NULL);
+
+  // and kernels of the selected core
+  arm_bench_core ();
+
+  return (EXIT_SUCCESS);
+}
+// ------------------------------------------------------------------------
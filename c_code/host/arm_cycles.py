@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+""" ARM instruction and cycle counts for the MLP core kernels
+
+    runs the ARM measurement harness (make arm, see host/arm_bench.c)
+    under QEMU user-mode emulation with the execlog TCG plugin and
+    reports, as JSON, the instructions executed by every kernel call
+    and an estimate of the ARM968E-S cycles they take.
+
+    usage: arm_cycles.py [--qemu <qemu-arm>] --plugin <libexeclog.so>
+                         [--nm <arm-none-eabi-nm>] [<harness elf> ...]
+
+    QEMU does not model the ARM968E-S, so the ARMv5TE arm946 CPU is
+    emulated and cycles are estimated from the executed instructions
+    with the ARM968E-S instruction timings: 1 cycle for most
+    instructions, plus multiply, load/store multiple, load-use interlock
+    and taken branch penalties. Memory is assumed to be zero wait-state
+    (DTCM), as is the case for the kernel data on SpiNNaker.
+"""
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+
+# harness binaries (arm_bench.mk)
+_BIN_DIR  = os.path.join (os.path.dirname (os.path.abspath (__file__)),
+                          "..", "..", "binaries", "arm")
+_HARNESS  = ["weight_bench.elf", "threshold_bench.elf"]
+
+# software division helpers (libgcc): 64-bit and 32-bit divides
+_DIV_SYMS = {"__aeabi_ldivmod", "__aeabi_uldivmod",
+             "__divdi3", "__udivdi3", "__moddi3", "__umoddi3",
+             "__aeabi_idiv", "__aeabi_uidiv", "__aeabi_idivmod",
+             "__aeabi_uidivmod"}
+
+# execlog lines: <cpu>, <pc>, <opcode>, "<disassembly>"[, <memory access>]
+_TRACE_RE = re.compile (r'^\s*\d+,\s*0x([0-9a-fA-F]+),\s*0x[0-9a-fA-F]+,'
+                        r'\s*"([^"]*)"')
+
+_COND     = ("eq|ne|cs|hs|cc|lo|mi|pl|vs|vc|hi|ls|ge|lt|gt|le|al")
+_REG_RE   = re.compile (r'\b(r\d+|sb|sl|fp|ip|sp|lr|pc)\b')
+_SHIFT_RE = re.compile (r'\b(lsl|lsr|asr|ror)\s+(r\d+|sb|sl|fp|ip|lr)\b')
+
+
+def _base (mnemonic):
+    """ mnemonic without condition code (and .w/.n qualifiers)
+    """
+    _m = mnemonic.split (".")[0]
+
+    # conditional branches first: bls, blt and ble are not bl
+    if re.fullmatch (r'b(' + _COND + r')?', _m):
+        return "b"
+
+    for _root in ("smlal", "umlal", "smull", "umull", "mla", "mul",
+                  "ldm", "stm", "ldrd", "strd", "ldr", "str",
+                  "push", "pop", "blx", "bx", "bl", "b"):
+        if _m.startswith (_root):
+            _rest = _m[len (_root):]
+            if re.fullmatch (r'(s)?(' + _COND + r')?(s)?'
+                             r'(ia|ib|da|db|fd|ed|fa|ea|b|h|sb|sh|t|bt)?'
+                             r'(' + _COND + r')?', _rest):
+                return _root
+    return _m
+
+
+def _cycles (mnemonic, operands, taken):
+    """ ARM968E-S cycles of one executed instruction
+        (without the load-use interlock, added by the caller)
+    """
+    _m = _base (mnemonic)
+    _regs = _REG_RE.findall (operands)
+
+    if _m in ("b", "bl", "bx", "blx"):
+        return 3 if taken else 1
+
+    if _m in ("mul", "mla"):
+        return 2
+
+    if _m in ("smull", "umull", "smlal", "umlal"):
+        return 3
+
+    if _m in ("ldm", "pop"):
+        _n = len (_REG_RE.findall (operands.split ("{")[-1])) \
+            if "{" in operands else 1
+        return max (_n, 2) + (2 if "pc" in operands.split ("{")[-1] else 0)
+
+    if _m in ("stm", "push"):
+        _n = len (_REG_RE.findall (operands.split ("{")[-1])) \
+            if "{" in operands else 1
+        return max (_n, 2)
+
+    if _m in ("ldrd", "strd"):
+        return 2
+
+    if _m == "ldr":
+        return 4 if (_regs and _regs[0] == "pc") else 1
+
+    if _m == "str":
+        return 1
+
+    # data processing: register-specified shifts take an extra cycle,
+    # writing the pc flushes the pipeline
+    _c = 1
+    if _SHIFT_RE.search (operands) or \
+            (_m in ("lsl", "lsr", "asr", "ror") and len (_regs) == 3):
+        _c += 1
+    if _regs and _regs[0] == "pc":
+        _c += 2
+    return _c
+
+
+def _loaded_regs (mnemonic, operands):
+    """ registers written by a load (for load-use interlocks)
+    """
+    _m = _base (mnemonic)
+    if _m in ("ldr", "ldrd"):
+        _regs = _REG_RE.findall (operands.split ("[")[0])
+        return set (_regs)
+    return set ()
+
+
+def _symbols (nm, elf):
+    """ addresses of the markers and division helpers
+    """
+    _out = subprocess.run ([nm, elf], check = True, stdout = subprocess.PIPE,
+                           universal_newlines = True).stdout
+    _syms = {}
+    for _line in _out.splitlines ():
+        _f = _line.split ()
+        if len (_f) == 3:
+            # thumb symbols have the lsb set
+            _syms[_f[2]] = int (_f[0], 16) & ~1
+    return _syms
+
+
+def _measure (qemu, plugin, nm, elf):
+    """ run one harness and count instructions and cycles
+        between its start and stop markers
+    """
+    _syms = _symbols (nm, elf)
+    _start = _syms["arm_bench_start"]
+    _stop  = _syms["arm_bench_stop"]
+    _divs  = {_syms[s] for s in _DIV_SYMS if s in _syms}
+
+    with tempfile.TemporaryDirectory (prefix = "arm_cycles_") as _dir:
+        _log = os.path.join (_dir, "exec.log")
+        _run = subprocess.run (
+            [qemu, "-cpu", "arm946", "-semihosting",
+             "-plugin", plugin, "-d", "plugin", "-D", _log, elf],
+            check = True, stdout = subprocess.PIPE, universal_newlines = True
+            )
+
+        _labels = [l.split ()[1:] for l in _run.stdout.splitlines ()
+                   if l.startswith ("measure ")]
+
+        _results = []
+        _active = False
+        _prev = None
+        with open (_log) as f:
+            for _line in f:
+                _t = _TRACE_RE.match (_line)
+                if _t is None:
+                    continue
+
+                _pc = int (_t.group (1), 16)
+                _insn = _t.group (2).split (None, 1)
+                _mnem = _insn[0]
+                _ops = _insn[1] if len (_insn) > 1 else ""
+
+                # cost of the previous instruction: taken branches and
+                # load-use interlocks depend on the next one
+                if _prev is not None:
+                    _ppc, _pm, _pops = _prev
+                    _taken = _pc not in (_ppc + 4, _ppc + 2)
+                    _c = _cycles (_pm, _pops, _taken)
+                    if _loaded_regs (_pm, _pops) & \
+                            set (_REG_RE.findall (_ops)):
+                        _c += 1
+                    _cur["cycles"] += _c
+                    _prev = None
+
+                if _pc == _start:
+                    _cur = {"instructions": 0, "cycles": 0, "div_calls": 0,
+                            "long_muls": 0}
+                    _active = True
+
+                elif _pc == _stop and _active:
+                    _results.append (_cur)
+                    _active = False
+
+                if _active:
+                    _cur["instructions"] += 1
+                    if _pc in _divs:
+                        _cur["div_calls"] += 1
+                    if _base (_mnem) in ("smull", "umull", "smlal", "umlal"):
+                        _cur["long_muls"] += 1
+                    _prev = (_pc, _mnem, _ops)
+
+    if len (_results) != len (_labels):
+        sys.exit (f"error: {elf}: {len (_labels)} measurements announced, "
+                  f"{len (_results)} traced")
+
+    return list (zip (_labels, _results))
+
+
+def main ():
+    _p = argparse.ArgumentParser (
+        description = "ARM968 instruction and cycle counts per kernel call")
+    _p.add_argument ("--qemu", default = "qemu-arm")
+    _p.add_argument ("--plugin", required = True,
+                     help = "path to the QEMU execlog plugin (libexeclog.so)")
+    _p.add_argument ("--nm", default = "arm-none-eabi-nm")
+    _p.add_argument ("elf", nargs = "*",
+                     default = [os.path.join (_BIN_DIR, h) for h in _HARNESS])
+    _args = _p.parse_args ()
+
+    _report = []
+    for _elf in _args.elf:
+        _meas = _measure (_args.qemu, _args.plugin, _args.nm, _elf)
+
+        # the empty calibration measurement is the marker overhead
+        _base_i = _meas[0][1]["instructions"]
+        _base_c = _meas[0][1]["cycles"]
+
+        for (_name, _core, _size, _elements), _r in _meas[1:]:
+            _i = _r["instructions"] - _base_i
+            _c = _r["cycles"] - _base_c
+            _e = max (int (_elements), 1)
+            _report.append ({
+                "kernel": _name, "core": _core, "size": int (_size),
+                "elements": int (_elements),
+                "instructions": _i, "cycles": _c,
+                "instructions_per_element": round (_i / _e, 2),
+                "cycles_per_element": round (_c / _e, 2),
+                "ops": {"long_mul": _r["long_muls"],
+                        "div_calls": _r["div_calls"]}
+                })
+
+    json.dump (_report, sys.stdout, indent = 2)
+    print ()
+
+
+if __name__ == "__main__":
+    main ()
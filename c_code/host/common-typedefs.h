@@ -0,0 +1,12 @@
+#ifndef __COMMON_TYPEDEFS_H__
+#define __COMMON_TYPEDEFS_H__
+
+// ------------------------------------------------------------------------
+// host replacement for the front-end-common type definitions
+// ------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint32_t * address_t;
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef __DATA_SPECIFICATION_H__
+#define __DATA_SPECIFICATION_H__
+
+// ------------------------------------------------------------------------
+// host replacement for the front-end-common data specification interface
+// regions are the ones written by the python vertices and loaded
+// from the host graph file by the simulator
+// ------------------------------------------------------------------------
+#include "common-typedefs.h"
+
+typedef struct data_specification_metadata_t data_specification_metadata_t;
+
+data_specification_metadata_t * data_specification_get_data_address (void);
+bool data_specification_read_header (data_specification_metadata_t * ds);
+void * data_specification_get_region (uint32_t region,
+                                      data_specification_metadata_t * ds);
+
+#endif
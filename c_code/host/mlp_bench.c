@@ -0,0 +1,1044 @@
+// microbenchmarks for the MLP core kernels
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+
+#include "mlp_params.h"
+#include "mlp_types.h"
+#include "mlp_macros.h"
+#include "mlp_host.h"
+
+
+// ------------------------------------------------------------------------
+// usage: mlp_bench [-b <binaries dir>] [-s <max block size>] [-m <ms>]
+//                  [-w <weight bits>]
+//
+// runs the hot kernels of the weight, sum and threshold cores in isolation
+// on square blocks of 1, 2, 4, ... up to <max block size> units (default
+// MAX_BLK_UNITS) and prints one JSON object per kernel and block size.
+// Every measurement runs for at least <ms> milliseconds (default 20).
+// Weight core kernels use 32-bit weights, or 16-bit weights (SPINN_WEIGHT_16)
+// if <weight bits> is 16.
+//
+// kernels are called in the core binaries built for mlp_host (make host),
+// with their globals set up directly. Thread semaphores are set so that
+// kernels never advance the tick.
+//
+// reported op counts are the fixed-point operations in the kernel source
+// for one call: 64-bit multiplies, 64-bit divides, table look-ups and
+// square roots. Sent packets are counted as they happen.
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// benchmark constants
+// ------------------------------------------------------------------------
+// largest weight block (MLPConstants.MAX_BLK_UNITS in mlp_types.py)
+#define BENCH_MAX_BLK_UNITS  48
+
+// partial nets expected by a sum core (MAX_SLICE_UNITS / MAX_BLK_UNITS)
+#define BENCH_FWD_EXPECTED   3
+
+#define BENCH_MIN_MS         20
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// simulator state expected by the spin1 shim
+// ------------------------------------------------------------------------
+HOST_THREAD_LOCAL host_core_t * host_cur = NULL;
+uint           host_verbose = FALSE;
+
+static host_core_t    bench_core = {.label = "bench"};
+static uint           bench_sent;     // packets sent by the kernels
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// kernel description
+// ------------------------------------------------------------------------
+typedef struct bench_ops
+{
+  uint elements;                      // elements processed per call
+  uint mul;                           // 64-bit multiplies per call
+  uint div;                           // 64-bit divides per call
+  uint lut;                           // table look-ups per call
+  uint sqrt;                          // square roots per call
+} bench_ops_t;
+
+
+typedef struct bench_kernel
+{
+  const char * name;
+  const char * core;
+  void      (* setup) (uint size, bench_ops_t * ops);
+  void      (* reset) (void);         // restore state (not timed) or NULL
+  void      (* run) (void);           // one call
+} bench_kernel_t;
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// core instances and their globals
+// ------------------------------------------------------------------------
+static char         * bin_dir = NULL;
+
+static void         * w_lib;
+static void         * s_lib;
+static void         * t_lib;
+
+static uint           size;           // current block size
+static uchar          bench_wfmt = SPINN_WEIGHT_32;  // weight storage
+
+// weight core
+static w_conf_t       * wcfg;
+static network_conf_t * w_ncfg;
+static stage_conf_t   * w_xcfg;
+static weight_t     * * w_weights;
+static weight_t     * * w_weights_bp;
+static short_weight_t * * w_sweights;
+static short_weight_t * * w_sweights_bp;
+static w_wchange_t  * * w_wchanges;
+static activation_t * * w_outputs;
+static long_net_t   * * w_nets;
+static uchar          * w_nets_rdy;
+static uchar          * wf_stream;
+static activation_t * * w_output_history;
+static w_delta_t    * * w_link_deltas;
+static error_t      * * w_errors;
+static lds_t          * w_lds_final;
+static uint           * wf_procs;
+static uint           * wf_comms;
+static scoreboard_t   * wf_arrived;
+static uint           * wf_thrds_pend;
+static scoreboard_t   * wb_arrived;
+static uint           * wb_thrds_pend;
+
+static void (* wf_process) (uint, uint);
+static void (* w_forward_packet) (uint, uint);
+static void (* wb_process) (uint, uint);
+static void (* steepest_update_weights) (void);
+static void (* momentum_update_weights) (void);
+static void (* dougsmomentum_update_weights) (void);
+static void (* w_refresh_weights) (void);
+
+// sum core
+static s_conf_t       * scfg;
+static long_net_t   * * s_nets;
+static scoreboard_t * * sf_arrived;
+static scoreboard_t   * sf_done;
+static uint           * sf_thrds_pend;
+static pkt_queue_t    * s_pkt_queue;
+static scoreboard_t * * sf_batch;
+static uint         * * sf_batch_units;
+static uchar          * s_active;
+
+static void (* sf_process) (uint, uint);
+static void (* s_processQueue) (uint, uint);
+
+// threshold core
+static t_conf_t       * tcfg;
+static stage_conf_t   * t_xcfg;
+static activation_t * * t_outputs;
+static net_t        * * t_nets;
+static long_deriv_t * * t_output_deriv;
+static activation_t * * tt;
+static uint           * t_it_idx;
+
+static void (* compute_out) (uint);
+static void (* error_cross_entropy) (uint);
+static activation_t (* sigmoid) (net_t);
+static net_t (* inv_sigmoid) (activation_t);
+static wchange_t (* sqrt_custom) (lds_t);
+
+// reference weight block, restored before every weight update
+static weight_t       ref_weights[BENCH_MAX_BLK_UNITS * BENCH_MAX_BLK_UNITS];
+static short_weight_t ref_sweights[BENCH_MAX_BLK_UNITS * BENCH_MAX_BLK_UNITS];
+static w_wchange_t    ref_wchanges[BENCH_MAX_BLK_UNITS * BENCH_MAX_BLK_UNITS];
+
+// arguments of the element-wise kernels
+static net_t          bench_nets[BENCH_MAX_BLK_UNITS];
+static activation_t   bench_outs[BENCH_MAX_BLK_UNITS];
+static lds_t          bench_lds[BENCH_MAX_BLK_UNITS];
+
+static volatile int   bench_sink;     // keeps results alive
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// report a fatal error and exit
+// ------------------------------------------------------------------------
+static void bench_fail (const char * msg, const char * arg)
+{
+  fprintf (stderr, "mlp_bench: %s%s%s\n", msg, arg ? ": " : "", arg ? arg : "");
+  exit (EXIT_FAILURE);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// spin1 shim support: count packets, recording is not used
+// ------------------------------------------------------------------------
+uint host_route_packet (uint key, uint payload, uint load)
+{
+  (void) key;
+  (void) payload;
+  (void) load;
+
+  bench_sent++;
+
+  return (TRUE);
+}
+
+
+void host_buf_append (host_buf_t * buf, void const * data, uint size)
+{
+  (void) buf;
+  (void) data;
+  (void) size;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// deterministic pseudo-random values in [lo, hi)
+// ------------------------------------------------------------------------
+static uint64_t bench_seed = 0x9e3779b97f4a7c15ULL;
+
+static int bench_rand (int lo, int hi)
+{
+  bench_seed ^= bench_seed << 13;
+  bench_seed ^= bench_seed >> 7;
+  bench_seed ^= bench_seed << 17;
+
+  return (lo + (int) (bench_seed % (uint64_t) (hi - lo)));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// load a core binary and look up its symbols
+// ------------------------------------------------------------------------
+static void * bench_load (const char * name)
+{
+  char path[PATH_MAX];
+  snprintf (path, sizeof (path), "%s/%s.so", bin_dir, name);
+
+  void * lib = dlopen (path, RTLD_NOW | RTLD_LOCAL);
+  if (lib == NULL)
+  {
+    bench_fail ("cannot load core binary", dlerror ());
+  }
+
+  return (lib);
+}
+
+
+static void * bench_sym (void * lib, const char * name)
+{
+  void * sym = dlsym (lib, name);
+  if (sym == NULL)
+  {
+    bench_fail ("missing symbol", name);
+  }
+
+  return (sym);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// allocate a block as a single arena (as init_w.c)
+// ------------------------------------------------------------------------
+static void * bench_block (uint elem_size)
+{
+  return (calloc (BENCH_MAX_BLK_UNITS * BENCH_MAX_BLK_UNITS, elem_size));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// bind the globals and kernels of every core
+// ------------------------------------------------------------------------
+static void bench_init (void)
+{
+  host_cur = &bench_core;
+
+  w_lib = bench_load ("weight");
+  s_lib = bench_load ("sum");
+  t_lib = bench_load ("threshold");
+
+  // weight core,
+  wcfg          = bench_sym (w_lib, "wcfg");
+  w_ncfg        = bench_sym (w_lib, "ncfg");
+  w_xcfg        = bench_sym (w_lib, "xcfg");
+  w_weights     = bench_sym (w_lib, "w_weights");
+  w_weights_bp  = bench_sym (w_lib, "w_weights_bp");
+  w_sweights    = bench_sym (w_lib, "w_sweights");
+  w_sweights_bp = bench_sym (w_lib, "w_sweights_bp");
+  w_wchanges    = bench_sym (w_lib, "w_wchanges");
+  w_outputs     = bench_sym (w_lib, "w_outputs");
+  w_nets        = bench_sym (w_lib, "w_nets");
+  w_nets_rdy    = bench_sym (w_lib, "w_nets_rdy");
+  wf_stream     = bench_sym (w_lib, "wf_stream");
+  w_output_history = bench_sym (w_lib, "w_output_history");
+  w_link_deltas = bench_sym (w_lib, "w_link_deltas");
+  w_errors      = bench_sym (w_lib, "w_errors");
+  w_lds_final   = bench_sym (w_lib, "w_lds_final");
+  wf_procs      = bench_sym (w_lib, "wf_procs");
+  wf_comms      = bench_sym (w_lib, "wf_comms");
+  wf_arrived    = bench_sym (w_lib, "wf_arrived");
+  wf_thrds_pend = bench_sym (w_lib, "wf_thrds_pend");
+  wb_arrived    = bench_sym (w_lib, "wb_arrived");
+  wb_thrds_pend = bench_sym (w_lib, "wb_thrds_pend");
+
+  wf_process = bench_sym (w_lib, "wf_process");
+  w_forward_packet = bench_sym (w_lib, "w_forward_packet");
+  wb_process = bench_sym (w_lib, "wb_process");
+  steepest_update_weights = bench_sym (w_lib, "steepest_update_weights");
+  momentum_update_weights = bench_sym (w_lib, "momentum_update_weights");
+  dougsmomentum_update_weights =
+    bench_sym (w_lib, "dougsmomentum_update_weights");
+  w_refresh_weights = bench_sym (w_lib, "w_refresh_weights");
+
+  *w_weights     = bench_block (sizeof (weight_t));
+  *w_weights_bp  = bench_block (sizeof (weight_t));
+  *w_sweights    = bench_block (sizeof (short_weight_t));
+  *w_sweights_bp = bench_block (sizeof (short_weight_t));
+  *w_wchanges    = bench_block (sizeof (w_wchange_t));
+  *w_link_deltas = bench_block (sizeof (w_delta_t));
+  *w_errors      = calloc (BENCH_MAX_BLK_UNITS, sizeof (error_t));
+  w_outputs[0]   = calloc (BENCH_MAX_BLK_UNITS, sizeof (activation_t));
+  w_outputs[1]   = calloc (BENCH_MAX_BLK_UNITS, sizeof (activation_t));
+  w_nets[0]      = calloc (BENCH_MAX_BLK_UNITS, sizeof (long_net_t));
+  w_nets[1]      = calloc (BENCH_MAX_BLK_UNITS, sizeof (long_net_t));
+
+  // output history of tick 0 only
+  *w_output_history = calloc (BENCH_MAX_BLK_UNITS, sizeof (activation_t));
+
+  // sum core,
+  scfg          = bench_sym (s_lib, "scfg");
+  s_nets        = bench_sym (s_lib, "s_nets");
+  sf_arrived    = bench_sym (s_lib, "sf_arrived");
+  sf_done       = bench_sym (s_lib, "sf_done");
+  sf_thrds_pend = bench_sym (s_lib, "sf_thrds_pend");
+  s_pkt_queue   = bench_sym (s_lib, "s_pkt_queue");
+  s_active      = bench_sym (s_lib, "s_active");
+  sf_batch      = bench_sym (s_lib, "sf_batch");
+  sf_batch_units = bench_sym (s_lib, "sf_batch_units");
+
+  sf_process = bench_sym (s_lib, "sf_process");
+  s_processQueue = bench_sym (s_lib, "s_processQueue");
+
+  s_pkt_queue->queue = calloc (SPINN_SUM_PQ_LEN, sizeof (packet_t));
+  *sf_batch_units = calloc (2 * BENCH_MAX_BLK_UNITS, sizeof (uint));
+
+  for (uint c = 0; c < 2; c++)
+  {
+    s_nets[c]     = calloc (BENCH_MAX_BLK_UNITS, sizeof (long_net_t));
+    sf_arrived[c] = calloc (BENCH_MAX_BLK_UNITS, sizeof (scoreboard_t));
+    sf_batch[c]   = calloc (BENCH_MAX_BLK_UNITS, sizeof (scoreboard_t));
+  }
+
+  // and threshold core
+  tcfg           = bench_sym (t_lib, "tcfg");
+  t_xcfg         = bench_sym (t_lib, "xcfg");
+  t_outputs      = bench_sym (t_lib, "t_outputs");
+  t_nets         = bench_sym (t_lib, "t_nets");
+  t_output_deriv = bench_sym (t_lib, "t_output_deriv");
+  tt             = bench_sym (t_lib, "tt");
+  t_it_idx       = bench_sym (t_lib, "t_it_idx");
+
+  compute_out         = bench_sym (t_lib, "compute_out");
+  error_cross_entropy = bench_sym (t_lib, "error_cross_entropy");
+  sigmoid             = bench_sym (t_lib, "sigmoid");
+  inv_sigmoid         = bench_sym (t_lib, "inv_sigmoid");
+  sqrt_custom         = bench_sym (t_lib, "sqrt_custom");
+
+  *t_outputs      = calloc (BENCH_MAX_BLK_UNITS, sizeof (activation_t));
+  *t_nets         = calloc (BENCH_MAX_BLK_UNITS, sizeof (net_t));
+  *t_output_deriv = calloc (BENCH_MAX_BLK_UNITS, sizeof (long_deriv_t));
+  *tt             = calloc (BENCH_MAX_BLK_UNITS, sizeof (activation_t));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// weight core kernels
+// ------------------------------------------------------------------------
+// random block: weights in (-2, 2), outputs in [0, 1), deltas in (-1, 1)
+// ------------------------------------------------------------------------
+static void weight_setup (uint n)
+{
+  wcfg->num_rows = n;
+  wcfg->num_cols = n;
+  wcfg->learningRate = (short_fpreal) (0.1 * (1 << SPINN_SHORT_FPREAL_SHIFT));
+  wcfg->momentum     = (short_fpreal) (0.9 * (1 << SPINN_SHORT_FPREAL_SHIFT));
+  wcfg->weightDecay  = (short_fpreal) (0.001 * (1 << SPINN_SHORT_FPREAL_SHIFT));
+  wcfg->weight_format = bench_wfmt;
+
+  w_ncfg->net_type = SPINN_NET_FEED_FWD;
+  w_xcfg->update_function = SPINN_STEEPEST_UPDATE;
+
+  *wf_procs = 0;
+  *wf_comms = 1;
+  *wf_arrived = 0;
+
+  // received outputs are streamed into the partial nets
+  *wf_stream = TRUE;
+  w_nets_rdy[0] = TRUE;
+  w_nets_rdy[1] = TRUE;
+
+  for (uint i = 0; i < n; i++)
+  {
+    w_outputs[0][i] = bench_rand (0, SPINN_ACTIV_ONE);
+    w_outputs[1][i] = w_outputs[0][i];
+
+    for (uint j = 0; j < n; j++)
+    {
+      uint k = SPINN_W_INX (i, j, SPINN_W_STRIDE (n, n));
+
+      // zero weights are unconnected links: keep every link
+      weight_t w = bench_rand (-2 * SPINN_WEIGHT_ONE, 2 * SPINN_WEIGHT_ONE);
+      ref_weights[k] = (w == 0) ? 1 : w;
+      w >>= (SPINN_WEIGHT_SHIFT - SPINN_SHORT_WEIGHT_SHIFT);
+      ref_sweights[k] = (w == 0) ? 1 : (short_weight_t) w;
+      ref_wchanges[k] = bench_rand (-(1 << 16), 1 << 16);
+
+      (*w_weights)[k] = ref_weights[k];
+      (*w_weights_bp)[k] = ref_weights[k];
+      (*w_sweights)[k] = ref_sweights[k];
+      (*w_sweights_bp)[k] = ref_sweights[k];
+      (*w_wchanges)[k] = ref_wchanges[k];
+      (*w_link_deltas)[k] = bench_rand (-(1 << SPINN_LONG_DELTA_SHIFT),
+                                        1 << SPINN_LONG_DELTA_SHIFT);
+    }
+  }
+
+  // link delta sum above one exercises the square root
+  *w_lds_final = 1000 << SPINN_LDS_SHIFT;
+}
+
+
+static void weight_reset (void)
+{
+  memcpy (*w_weights, ref_weights, size * size * sizeof (weight_t));
+  memcpy (*w_weights_bp, ref_weights, size * size * sizeof (weight_t));
+  memcpy (*w_sweights, ref_sweights, size * size * sizeof (short_weight_t));
+  memcpy (*w_sweights_bp, ref_sweights,
+          size * size * sizeof (short_weight_t));
+  memcpy (*w_wchanges, ref_wchanges, size * size * sizeof (w_wchange_t));
+}
+// ------------------------------------------------------------------------
+
+
+// outputs were streamed: only the partial nets are sent
+static void wf_setup (uint n, bench_ops_t * ops)
+{
+  weight_setup (n);
+
+  ops->elements = n;
+}
+
+
+static void wf_run (void)
+{
+  // other threads pending: do not advance tick
+  *wf_thrds_pend = SPINN_WF_THRDS;
+
+  wf_process (0, 0);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// one call streams the outputs of a whole tick (num_rows packets)
+// ------------------------------------------------------------------------
+static void wfp_setup (uint n, bench_ops_t * ops)
+{
+  weight_setup (n);
+
+  ops->elements = n * n;
+  ops->mul      = n * n;
+}
+
+
+static void wfp_run (void)
+{
+  // other threads pending: do not advance tick
+  *wf_thrds_pend = SPINN_WF_THRDS;
+
+  for (uint i = 0; i < size; i++)
+  {
+    w_forward_packet (i, (uint) w_outputs[0][i]);
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// one call processes the deltas of a whole tick (num_cols packets)
+// ------------------------------------------------------------------------
+static void wb_setup (uint n, bench_ops_t * ops)
+{
+  weight_setup (n);
+
+  *wb_arrived = 0;
+
+  for (uint j = 0; j < n; j++)
+  {
+    bench_nets[j] = bench_rand (-(1 << SPINN_DELTA_SHIFT), 1 << SPINN_DELTA_SHIFT);
+  }
+
+  ops->elements = n * n;
+  ops->mul      = 2 * n * n;
+}
+
+
+static void wb_run (void)
+{
+  // other threads pending: do not advance tick
+  *wb_thrds_pend = SPINN_WB_THRDS | SPINN_THRD_COMS;
+
+  for (uint j = 0; j < size; j++)
+  {
+    wb_process (j, (uint) bench_nets[j]);
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// learning rate and weight decay multiplies (and momentum if used)
+// ------------------------------------------------------------------------
+static void steepest_setup (uint n, bench_ops_t * ops)
+{
+  weight_setup (n);
+
+  ops->elements = n * n;
+  ops->mul      = 2 * n * n;
+}
+
+
+static void steepest_run (void)
+{
+  steepest_update_weights ();
+}
+
+
+static void momentum_setup (uint n, bench_ops_t * ops)
+{
+  weight_setup (n);
+
+  ops->elements = n * n;
+  ops->mul      = 3 * n * n;
+}
+
+
+static void momentum_run (void)
+{
+  momentum_update_weights ();
+}
+
+
+// the learning rate is scaled once per call by 1 / sqrt (lds)
+static void dougsmomentum_setup (uint n, bench_ops_t * ops)
+{
+  weight_setup (n);
+
+  ops->elements = n * n;
+  ops->mul      = 3 * n * n + 1;
+  ops->div      = 1;
+  ops->sqrt     = 1;
+}
+
+
+static void dougsmomentum_run (void)
+{
+  dougsmomentum_update_weights ();
+}
+
+
+// FORWARD weights copied from the BACKPROP copy (SPINN_W_DUAL builds)
+static void refresh_setup (uint n, bench_ops_t * ops)
+{
+  weight_setup (n);
+
+  ops->elements = n * n;
+}
+
+
+static void refresh_run (void)
+{
+  w_refresh_weights ();
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// sum core kernel
+// ------------------------------------------------------------------------
+// one call accumulates the partial nets of a whole tick
+// ------------------------------------------------------------------------
+static void sf_setup (uint n, bench_ops_t * ops)
+{
+  scfg->num_units    = n;
+  scfg->fwd_expected = BENCH_FWD_EXPECTED;
+
+  *sf_done = 0;
+
+  for (uint i = 0; i < n; i++)
+  {
+    bench_nets[i] = bench_rand (-(1 << SPINN_NET_SHIFT), 1 << SPINN_NET_SHIFT);
+  }
+
+  ops->elements = n * BENCH_FWD_EXPECTED;
+}
+
+
+static void sf_run (void)
+{
+  // other threads pending: do not advance tick
+  *sf_thrds_pend = SPINN_SF_THRDS;
+
+  for (uint b = 0; b < BENCH_FWD_EXPECTED; b++)
+  {
+    for (uint i = 0; i < size; i++)
+    {
+      sf_process (i, (uint) bench_nets[i]);
+    }
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// sum core packet queue: one FORWARD packet per weight of a block, up to
+// a full queue (SPINN_SUM_PQ_LEN), dequeued and accumulated into nets.
+// s_processQueue (lock-free, masked indices, batches of partial nets) is
+// compared with the previous scheme, which disabled interrupts around
+// every dequeue, wrapped indices with a modulo and passed every packet
+// to sf_process.
+// ------------------------------------------------------------------------
+static uint           bench_pq_len;   // packets in the queue
+
+
+static void pkt_queue_setup (uint n, bench_ops_t * ops)
+{
+  sf_setup (n, ops);
+
+  bench_pq_len = n * n;
+  if (bench_pq_len > SPINN_SUM_PQ_LEN - 1)
+  {
+    bench_pq_len = SPINN_SUM_PQ_LEN - 1;
+  }
+
+  ops->elements = bench_pq_len;
+}
+
+
+static void pkt_queue_reset (void)
+{
+  // other threads pending: do not advance tick
+  *sf_thrds_pend = SPINN_SF_THRDS;
+
+  for (uint p = 0; p < bench_pq_len; p++)
+  {
+    s_pkt_queue->queue[p].key     = p % size;
+    s_pkt_queue->queue[p].payload = (uint) bench_nets[p % size];
+  }
+
+  s_pkt_queue->head = 0;
+  s_pkt_queue->tail = bench_pq_len;
+  *s_active = TRUE;
+}
+
+
+static void s_process_queue_run (void)
+{
+  s_processQueue (0, 0);
+}
+
+
+static void pkt_queue_modulo_run (void)
+{
+  uint cpsr = spin1_int_disable ();
+
+  while (s_pkt_queue->head != s_pkt_queue->tail)
+  {
+    uint key = s_pkt_queue->queue[s_pkt_queue->head].key;
+    uint payload = s_pkt_queue->queue[s_pkt_queue->head].payload;
+    s_pkt_queue->head = (s_pkt_queue->head + 1) % SPINN_SUM_PQ_LEN;
+
+    spin1_mode_restore (cpsr);
+
+    if ((key & SPINN_TYPE_MASK) == SPINN_DATA_KEY)
+    {
+      sf_process (key, payload);
+    }
+
+    cpsr = spin1_int_disable ();
+  }
+
+  *s_active = FALSE;
+
+  spin1_mode_restore (cpsr);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// threshold core kernels
+// ------------------------------------------------------------------------
+// nets in (-16, 16), outputs in (0, 1), targets 0 or 1
+// ------------------------------------------------------------------------
+static void threshold_setup (uint n)
+{
+  tcfg->num_units     = n;
+  tcfg->output_grp    = TRUE;
+  tcfg->num_out_procs = 1;
+  tcfg->procs_list[0] = SPINN_OUT_LOGISTIC;
+
+  // test mode: output derivatives are not stored
+  t_xcfg->training = FALSE;
+
+  *t_it_idx = 0;
+
+  for (uint i = 0; i < n; i++)
+  {
+    (*t_nets)[i] = bench_rand (-(16 << SPINN_NET_SHIFT), 16 << SPINN_NET_SHIFT);
+    (*tt)[i]     = (i & 1) ? SPINN_ACTIV_ONE : 0;
+
+    bench_nets[i] = (*t_nets)[i];
+    bench_outs[i] = bench_rand (SPINN_ACTIV_ONE / 16,
+                                SPINN_ACTIV_ONE - SPINN_ACTIV_ONE / 16);
+    bench_lds[i]  = bench_rand (SPINN_LDS_ONE + 1, 1 << 24);
+  }
+}
+
+
+static void compute_out_setup (uint n, bench_ops_t * ops)
+{
+  threshold_setup (n);
+
+  ops->elements = n;
+  ops->mul      = n;
+  ops->lut      = 2 * n;
+}
+
+
+static void compute_out_run (void)
+{
+  for (uint i = 0; i < size; i++)
+  {
+    compute_out (i);
+  }
+}
+
+
+static void cross_entropy_setup (uint n, bench_ops_t * ops)
+{
+  threshold_setup (n);
+
+  memcpy (*t_outputs, bench_outs, n * sizeof (activation_t));
+
+  ops->elements = n;
+  ops->div      = n;
+}
+
+
+static void cross_entropy_run (void)
+{
+  for (uint i = 0; i < size; i++)
+  {
+    error_cross_entropy (i);
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// activation functions (linked into every core)
+// ------------------------------------------------------------------------
+static void sigmoid_setup (uint n, bench_ops_t * ops)
+{
+  threshold_setup (n);
+
+  ops->elements = n;
+  ops->mul      = n;
+  ops->lut      = 2 * n;
+}
+
+
+static void sigmoid_run (void)
+{
+  int s = 0;
+  for (uint i = 0; i < size; i++)
+  {
+    s += sigmoid (bench_nets[i]);
+  }
+  bench_sink = s;
+}
+
+
+static void inv_sigmoid_run (void)
+{
+  int s = 0;
+  for (uint i = 0; i < size; i++)
+  {
+    s += inv_sigmoid (bench_outs[i]);
+  }
+  bench_sink = s;
+}
+
+
+static void sqrt_setup (uint n, bench_ops_t * ops)
+{
+  threshold_setup (n);
+
+  ops->elements = n;
+  ops->sqrt     = n;
+}
+
+
+static void sqrt_run (void)
+{
+  int s = 0;
+  for (uint i = 0; i < size; i++)
+  {
+    s += sqrt_custom (bench_lds[i]);
+  }
+  bench_sink = s;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// benchmarked kernels
+// ------------------------------------------------------------------------
+static const bench_kernel_t kernels[] =
+{
+  {"w_forward_packet", "weight", wfp_setup, NULL, wfp_run},
+  {"wf_process",   "weight", wf_setup, NULL, wf_run},
+  {"wb_process",   "weight", wb_setup, NULL, wb_run},
+  {"steepest_update_weights", "weight",
+     steepest_setup, weight_reset, steepest_run},
+  {"momentum_update_weights", "weight",
+     momentum_setup, weight_reset, momentum_run},
+  {"dougsmomentum_update_weights", "weight",
+     dougsmomentum_setup, weight_reset, dougsmomentum_run},
+  {"w_refresh_weights", "weight", refresh_setup, NULL, refresh_run},
+  {"sf_process",   "sum",       sf_setup, NULL, sf_run},
+  {"s_processQueue", "sum",
+     pkt_queue_setup, pkt_queue_reset, s_process_queue_run},
+  {"pkt_queue_modulo", "sum",
+     pkt_queue_setup, pkt_queue_reset, pkt_queue_modulo_run},
+  {"compute_out",  "threshold", compute_out_setup, NULL, compute_out_run},
+  {"error_cross_entropy", "threshold",
+     cross_entropy_setup, NULL, cross_entropy_run},
+  {"sigmoid",      "activation", sigmoid_setup, NULL, sigmoid_run},
+  {"inv_sigmoid",  "activation", sigmoid_setup, NULL, inv_sigmoid_run},
+  {"sqrt_custom",  "activation", sqrt_setup, NULL, sqrt_run}
+};
+
+#define BENCH_NUM_KERNELS  (sizeof (kernels) / sizeof (kernels[0]))
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// time in ns
+// ------------------------------------------------------------------------
+static uint64_t bench_now (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+
+  return ((uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// measure one kernel for the current block size and report it
+// kernels with a reset function are timed call by call, so that the
+// reset is not included, and the timer overhead is discounted
+// ------------------------------------------------------------------------
+static void bench_kernel (bench_kernel_t const * k, uint64_t min_ns,
+                          uint64_t timer_ns, uint first)
+{
+  bench_ops_t ops = {0};
+  k->setup (size, &ops);
+
+  // warm up and count packets sent per call,
+  if (k->reset != NULL)
+  {
+    k->reset ();
+  }
+  bench_sent = 0;
+  k->run ();
+  uint pkts = bench_sent;
+
+  // then time batches of calls until long enough
+  uint64_t calls = 0;
+  uint64_t ns = 0;
+  uint batch = 1;
+  while (ns < min_ns)
+  {
+    if (k->reset == NULL)
+    {
+      uint64_t start = bench_now ();
+      for (uint n = 0; n < batch; n++)
+      {
+        k->run ();
+      }
+      ns += bench_now () - start;
+    }
+    else
+    {
+      for (uint n = 0; n < batch; n++)
+      {
+        k->reset ();
+        uint64_t start = bench_now ();
+        k->run ();
+        uint64_t t = bench_now () - start;
+        ns += (t > timer_ns) ? t - timer_ns : 0;
+      }
+    }
+
+    calls += batch;
+    if (batch < (1 << 20))
+    {
+      batch *= 2;
+    }
+  }
+
+  double ns_call = (double) ns / (double) calls;
+
+  printf ("%s  {\"kernel\": \"%s\", \"core\": \"%s\", \"size\": %u, "
+          "\"elements\": %u, \"calls\": %llu, \"ns_per_call\": %.2f, "
+          "\"ns_per_element\": %.3f, \"ops\": {\"mul\": %u, \"div\": %u, "
+          "\"lut\": %u, \"sqrt\": %u, \"packets\": %u}}",
+          first ? "" : ",\n", k->name, k->core, size, ops.elements,
+          (unsigned long long) calls, ns_call,
+          ns_call / (double) (ops.elements ? ops.elements : 1),
+          ops.mul, ops.div, ops.lut, ops.sqrt, pkts);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// cost of reading the timer, discounted from call-by-call timings
+// ------------------------------------------------------------------------
+static uint64_t bench_timer_overhead (void)
+{
+  uint64_t best = ~0ULL;
+
+  for (uint n = 0; n < 10000; n++)
+  {
+    uint64_t start = bench_now ();
+    uint64_t t = bench_now () - start;
+    if (t < best)
+    {
+      best = t;
+    }
+  }
+
+  return (best);
+}
+// ------------------------------------------------------------------------
+
+
+int main (int argc, char * argv[])
+{
+  uint max_size = BENCH_MAX_BLK_UNITS;
+  uint min_ms = BENCH_MIN_MS;
+
+  int opt;
+  while ((opt = getopt (argc, argv, "b:s:m:w:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'b':
+        bin_dir = optarg;
+        break;
+
+      case 's':
+        max_size = strtoul (optarg, NULL, 0);
+        break;
+
+      case 'm':
+        min_ms = strtoul (optarg, NULL, 0);
+        break;
+
+      case 'w':
+        if (strtoul (optarg, NULL, 0) == 16)
+        {
+          bench_wfmt = SPINN_WEIGHT_16;
+        }
+        else if (strtoul (optarg, NULL, 0) != 32)
+        {
+          bench_fail ("weight bits must be 16 or 32", NULL);
+        }
+        break;
+
+      default:
+        bench_fail ("usage: mlp_bench [-b <binaries dir>] "
+                    "[-s <max block size>] [-m <ms>] [-w <weight bits>]",
+                    NULL);
+    }
+  }
+
+  if ((max_size == 0) || (max_size > BENCH_MAX_BLK_UNITS))
+  {
+    bench_fail ("block size must be between 1 and MAX_BLK_UNITS", NULL);
+  }
+
+  // core binaries live next to the benchmark by default
+  if (bin_dir == NULL)
+  {
+    static char exe[PATH_MAX];
+    ssize_t n = readlink ("/proc/self/exe", exe, sizeof (exe) - 1);
+    if (n <= 0)
+    {
+      bench_fail ("cannot locate core binaries", NULL);
+    }
+    exe[n] = '\0';
+    *strrchr (exe, '/') = '\0';
+    bin_dir = exe;
+  }
+
+  bench_init ();
+
+  uint64_t timer_ns = bench_timer_overhead ();
+
+  printf ("[\n");
+
+  uint first = TRUE;
+  for (uint k = 0; k < BENCH_NUM_KERNELS; k++)
+  {
+    for (size = 1; size <= max_size; size *= 2)
+    {
+      bench_kernel (&kernels[k], (uint64_t) min_ms * 1000000, timer_ns, first);
+      first = FALSE;
+    }
+
+    // always include the largest block
+    if ((max_size & (max_size - 1)) != 0)
+    {
+      size = max_size;
+      bench_kernel (&kernels[k], (uint64_t) min_ms * 1000000, timer_ns, first);
+    }
+  }
+
+  printf ("\n]\n");
+
+  return (EXIT_SUCCESS);
+}
+// ------------------------------------------------------------------------
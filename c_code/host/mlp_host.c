@@ -0,0 +1,950 @@
+// host multicast-fabric simulator for the MLP cores
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+
+#include "mlp_params.h"
+#include "mlp_types.h"
+#include "mlp_host.h"
+
+
+// ------------------------------------------------------------------------
+// usage: mlp_host [-v] [-t <threads>] [-r <tx rate>] [-b <binaries dir>]
+//                 [-o <output dir>] <graph file>
+//
+// -t sets the number of threads that share every round (default 1),
+// -r limits the packets a core can send in a round to model a congested
+//    router (default 0: no limit),
+// commands are read from stdin, one per line:
+//   run [<stage configuration in hex>]  run a stage until every core is done
+//   quit                                 exit
+//
+// after every stage the simulator writes recorded channels to the output
+// directory, reporting each file with a "rec <core> <channel> <file>" line,
+// reports every core that had to queue outbound packets with a
+// "tx <core> <refused sends> <queue high-water mark>" line, and finishes with a
+// "stage <id> <status> <statistics>" line on stdout.
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// simulator state
+// ------------------------------------------------------------------------
+HOST_THREAD_LOCAL host_core_t * host_cur = NULL;  // core run by this thread
+uint           host_verbose = FALSE;  // forward io_printf output?
+
+static host_core_t  * cores;          // simulated cores
+static uint           num_cores;
+static host_route_t * routes;         // multicast routes
+static uint           num_routes;
+
+static uint           stage_id;       // current stage
+static uint           round_cnt;      // current round (mailbox parity)
+static uint           num_threads = 1; // threads that share every round
+static uint           tx_rate = 0;    // packets per core per round (0: any)
+
+static char         * bin_dir = NULL; // core binaries (shared objects)
+static char         * out_dir = ".";  // recorded data output
+static char           tmp_dir[] = "/tmp/mlp_host_XXXXXX";
+
+static const char   * core_names[] = {"weight", "sum", "threshold", "input"};
+static const char   * pkt_names[] = {"data", "sync", "ldst", "ldsa",
+                                     "ldsr", "crit", "stpn", "stop"};
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// round state shared by the worker threads
+// ------------------------------------------------------------------------
+static pthread_barrier_t round_barrier;
+static uint           next_core;      // next core to run in this round
+static uint           round_progress; // packets or callbacks in this round
+static uint           round_running;  // cores not done after this round
+static uint           round_error;    // a core failed in this round
+static const char   * stage_status;   // set when the stage is over
+
+static __thread host_mail_t * mail_free = NULL; // recycled mailbox entries
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// report a fatal error and exit
+// ------------------------------------------------------------------------
+static void host_fail (const char * msg, const char * arg)
+{
+  fprintf (stderr, "mlp_host: %s%s%s\n", msg, arg ? ": " : "", arg ? arg : "");
+  exit (EXIT_FAILURE);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// append data to a growable buffer
+// ------------------------------------------------------------------------
+void host_buf_append (host_buf_t * buf, void const * data, uint size)
+{
+  if (buf->size + size > buf->cap)
+  {
+    uint new_cap = (buf->cap == 0) ? 4096 : buf->cap;
+    while (buf->size + size > new_cap)
+    {
+      new_cap *= 2;
+    }
+
+    if ((buf->data = realloc (buf->data, new_cap)) == NULL)
+    {
+      host_fail ("out of memory", NULL);
+    }
+    buf->cap = new_cap;
+  }
+
+  memcpy (buf->data + buf->size, data, size);
+  buf->size += size;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// post a packet to a core mailbox -- any thread can post (lock-free push)
+// ------------------------------------------------------------------------
+static void host_mail_post (host_mail_t ** mailbox, host_pkt_t * pkt)
+{
+  host_mail_t * m = mail_free;
+  if (m != NULL)
+  {
+    mail_free = m->next;
+  }
+  else if ((m = malloc (sizeof (host_mail_t))) == NULL)
+  {
+    host_fail ("out of memory", NULL);
+  }
+  m->pkt = *pkt;
+
+  m->next = __atomic_load_n (mailbox, __ATOMIC_RELAXED);
+  while (!__atomic_compare_exchange_n (mailbox, &m->next, m, TRUE,
+                                       __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    ;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// order packets by sender, then by send order
+// ------------------------------------------------------------------------
+static int host_pkt_cmp (const void * a, const void * b)
+{
+  const host_pkt_t * pa = a;
+  const host_pkt_t * pb = b;
+
+  if (pa->src != pb->src)
+  {
+    return ((pa->src < pb->src) ? -1 : 1);
+  }
+
+  return ((pa->seq < pb->seq) ? -1 : (pa->seq > pb->seq));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// take every packet from a core mailbox into its batch, in sender order
+//NOTE: the order in which packets reach a mailbox depends on thread
+// timing, sorting them keeps the delivery order deterministic
+// ------------------------------------------------------------------------
+static uint host_mail_take (host_core_t * c, host_mail_t ** mailbox)
+{
+  host_mail_t * m = __atomic_exchange_n (mailbox, NULL, __ATOMIC_ACQUIRE);
+
+  uint num = 0;
+  while (m != NULL)
+  {
+    if (num == c->batch_cap)
+    {
+      c->batch_cap = (c->batch_cap == 0) ? 64 : 2 * c->batch_cap;
+      c->batch = realloc (c->batch, c->batch_cap * sizeof (host_pkt_t));
+      if (c->batch == NULL)
+      {
+        host_fail ("out of memory", NULL);
+      }
+    }
+    c->batch[num++] = m->pkt;
+
+    // recycle entry in this thread,
+    host_mail_t * next = m->next;
+    m->next = mail_free;
+    mail_free = m;
+    m = next;
+  }
+
+  // the mailbox is a stack: restore arrival order,
+  for (uint i = 0; i < num / 2; i++)
+  {
+    host_pkt_t tmp = c->batch[i];
+    c->batch[i] = c->batch[num - 1 - i];
+    c->batch[num - 1 - i] = tmp;
+  }
+
+  // and sort only if senders posted concurrently
+  for (uint i = 1; i < num; i++)
+  {
+    if (host_pkt_cmp (&c->batch[i - 1], &c->batch[i]) > 0)
+    {
+      qsort (c->batch, num, sizeof (host_pkt_t), host_pkt_cmp);
+      break;
+    }
+  }
+
+  return (num);
+}
+
+
+static void host_mail_release (void)
+{
+  while (mail_free != NULL)
+  {
+    host_mail_t * next = mail_free->next;
+    free (mail_free);
+    mail_free = next;
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// route a multicast packet sent by the current core -- the packet
+// is delivered in the next round.
+// With a router rate limit, each core injects at most tx_rate packets
+// per round and further packets are refused. A core that keeps trying
+// (busy-waits) gets a packet through after tx_rate refused attempts,
+// so that a callback is never stuck.
+// returns TRUE if the packet was accepted
+//NOTE: keys are allocated by the host exporter as (partition << 16),
+// so the route index can be taken straight from the key
+// ------------------------------------------------------------------------
+uint host_route_packet (uint key, uint payload, uint load)
+{
+  host_core_t * c = host_cur;
+
+  if ((tx_rate != 0) && (c->round_sent >= tx_rate))
+  {
+    if (++c->tx_wait < tx_rate)
+    {
+      return (FALSE);
+    }
+  }
+  c->tx_wait = 0;
+  c->round_sent++;
+
+  host_pkt_t pkt = {key, payload, load, c->id, c->num_sent};
+
+  c->num_sent++;
+  c->sent_type[(key & SPINN_TYPE_MASK) >> 12]
+    [(key & SPINN_PHASE_MASK) >> SPINN_PHASE_SHIFT]++;
+
+  uint r = key >> 16;
+  if ((r >= num_routes) || ((key & routes[r].mask) != routes[r].key))
+  {
+    c->num_dropped++;
+    return (TRUE);
+  }
+
+  uint next = (round_cnt + 1) & 1;
+  for (uint d = 0; d < routes[r].num_dests; d++)
+  {
+    host_mail_post (&cores[routes[r].dests[d]].mailbox[next], &pkt);
+  }
+
+  return (TRUE);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// run a callback on behalf of a core -- rt_error returns here
+// ------------------------------------------------------------------------
+static void host_invoke (host_core_t * c, callback_t cback, uint arg0,
+                         uint arg1)
+{
+  host_cur = c;
+  if (setjmp (c->abort) == 0)
+  {
+    cback (arg0, arg1);
+  }
+  host_cur = NULL;
+}
+
+
+static void host_invoke_void (host_core_t * c, void (*func) (void))
+{
+  host_cur = c;
+  if (setjmp (c->abort) == 0)
+  {
+    func ();
+  }
+  host_cur = NULL;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// read little-endian words from the graph file
+// ------------------------------------------------------------------------
+static uint32_t read_word (FILE * f)
+{
+  uint32_t w;
+  if (fread (&w, sizeof (w), 1, f) != 1)
+  {
+    host_fail ("truncated graph file", NULL);
+  }
+  return (w);
+}
+
+
+static void * read_block (FILE * f, uint32_t size)
+{
+  // pad to a whole number of words (regions are word-aligned)
+  uint32_t padded = (size + 3) & ~3;
+  void * data = calloc (1, padded + sizeof (uint32_t));
+  if ((padded != 0) && (fread (data, 1, padded, f) != padded))
+  {
+    host_fail ("truncated graph file", NULL);
+  }
+  return (data);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// load a private instance of a core binary
+//NOTE: dlopen returns the same instance for the same file, so every
+// core gets its own copy of the shared object
+// ------------------------------------------------------------------------
+static void * load_instance (host_core_t * c)
+{
+  char src[PATH_MAX];
+  char dst[PATH_MAX];
+
+  snprintf (src, sizeof (src), "%s/%s.so", bin_dir, core_names[c->kind]);
+  snprintf (dst, sizeof (dst), "%s/%u_%s.so", tmp_dir, c->id,
+            core_names[c->kind]);
+
+  FILE * in = fopen (src, "rb");
+  if (in == NULL)
+  {
+    host_fail ("cannot open core binary", src);
+  }
+  FILE * out = fopen (dst, "wb");
+  if (out == NULL)
+  {
+    host_fail ("cannot create core instance", dst);
+  }
+
+  char buf[65536];
+  size_t n;
+  while ((n = fread (buf, 1, sizeof (buf), in)) > 0)
+  {
+    fwrite (buf, 1, n, out);
+  }
+  fclose (in);
+  fclose (out);
+
+  void * lib = dlopen (dst, RTLD_NOW | RTLD_LOCAL);
+  if (lib == NULL)
+  {
+    host_fail ("cannot load core instance", dlerror ());
+  }
+
+  // the mapping remains valid after the file is removed
+  unlink (dst);
+
+  return (lib);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// load cores and routes from the graph file and run every c_main
+// ------------------------------------------------------------------------
+static void load_graph (const char * name)
+{
+  FILE * f = fopen (name, "rb");
+  if (f == NULL)
+  {
+    host_fail ("cannot open graph file", name);
+  }
+
+  if ((read_word (f) != HOST_GRAPH_MAGIC) ||
+      (read_word (f) != HOST_GRAPH_VERSION))
+  {
+    host_fail ("not a graph file", name);
+  }
+
+  num_cores  = read_word (f);
+  num_routes = read_word (f);
+
+  cores  = calloc (num_cores, sizeof (host_core_t));
+  routes = calloc (num_routes, sizeof (host_route_t));
+
+  // cores and their SDRAM regions,
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+
+    c->id   = i;
+    c->kind = read_word (f);
+    if (c->kind > SPINN_INPUT_PROC)
+    {
+      host_fail ("unknown core type", NULL);
+    }
+
+    uint32_t len = read_word (f);
+    c->label = read_block (f, len);
+
+    uint32_t nr = read_word (f);
+    for (uint r = 0; r < nr; r++)
+    {
+      uint32_t size = read_word (f);
+      void * data = read_block (f, size);
+      if (r < HOST_NUM_REGIONS)
+      {
+        c->region_size[r] = size;
+        c->region[r] = size ? data : NULL;
+      }
+    }
+  }
+
+  // multicast routes,
+  for (uint r = 0; r < num_routes; r++)
+  {
+    routes[r].key       = read_word (f);
+    routes[r].mask      = read_word (f);
+    routes[r].num_dests = read_word (f);
+    routes[r].dests     = calloc (routes[r].num_dests + 1, sizeof (uint));
+    for (uint d = 0; d < routes[r].num_dests; d++)
+    {
+      routes[r].dests[d] = read_word (f);
+      if (routes[r].dests[d] >= num_cores)
+      {
+        host_fail ("route to unknown core", NULL);
+      }
+    }
+  }
+
+  fclose (f);
+
+  // and instantiate and initialise every core
+  if (mkdtemp (tmp_dir) == NULL)
+  {
+    host_fail ("cannot create temporary directory", strerror (errno));
+  }
+
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+
+    c->lib = load_instance (c);
+
+    void (*c_main) (void) = (void (*) (void)) dlsym (c->lib, "c_main");
+    if (c_main == NULL)
+    {
+      host_fail ("core binary has no c_main", core_names[c->kind]);
+    }
+
+    host_invoke_void (c, c_main);
+
+    // outbound queue statistics (comms_tx.c),
+    c->tx_refused = dlsym (c->lib, "tx_refused_cnt");
+    c->tx_hwm    = dlsym (c->lib, "tx_hwm");
+
+    if (c->error)
+    {
+      host_fail ("core initialisation failed", c->label);
+    }
+
+    if (c->dtcm_used > HOST_DTCM_SIZE)
+    {
+      fprintf (stderr, "mlp_host: warning: %s uses %u bytes of DTCM\n",
+               c->label, c->dtcm_used);
+    }
+  }
+
+  rmdir (tmp_dir);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// report the state of the cores that have not finished
+// ------------------------------------------------------------------------
+static void report_stuck_cores (void)
+{
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+    if (c->done)
+    {
+      continue;
+    }
+
+    uint * epoch = dlsym (c->lib, "epoch");
+    uint * example_cnt = dlsym (c->lib, "example_cnt");
+    uint * tick = dlsym (c->lib, "tick");
+    uchar * phase = dlsym (c->lib, "phase");
+
+    fprintf (stderr, "mlp_host: %s stuck (h:%u e:%u p:%u t:%u)\n",
+             c->label, epoch ? *epoch : 0, example_cnt ? *example_cnt : 0,
+             phase ? *phase : 0, tick ? *tick : 0);
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// deliver a packet to a core -- packets for finished cores are discarded
+// ------------------------------------------------------------------------
+static void host_deliver (host_core_t * c, host_pkt_t * pkt)
+{
+  if (c->done)
+  {
+    c->num_late++;
+    return;
+  }
+
+  callback_t cback = c->events[pkt->load ? MCPL_PACKET_RECEIVED
+                                         : MC_PACKET_RECEIVED];
+  if (cback != NULL)
+  {
+    c->num_recv++;
+    host_invoke (c, cback, pkt->key, pkt->payload);
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// run one round of a core: receive the packets sent to it in the previous
+// round and run its highest-priority scheduled callback.
+// returns TRUE if the core did anything
+// ------------------------------------------------------------------------
+static uint host_step_core (host_core_t * c)
+{
+  uint progress = FALSE;
+
+  // a new round lets the core inject packets again,
+  c->round_sent = 0;
+
+  // deliver waiting packets,
+  uint num = host_mail_take (c, &c->mailbox[round_cnt & 1]);
+  for (uint n = 0; n < num; n++)
+  {
+    progress = TRUE;
+    host_deliver (c, &c->batch[n]);
+  }
+
+  // and run the highest-priority callback
+  if (!c->done)
+  {
+    for (uint p = 0; p < HOST_NUM_PRIORITIES; p++)
+    {
+      host_task_queue_t * q = &c->tasks[p];
+      if (q->head != q->tail)
+      {
+        host_task_t t = q->queue[q->head % q->cap];
+        q->head++;
+        progress = TRUE;
+
+        c->num_tasks++;
+        host_invoke (c, t.cback, t.arg0, t.arg1);
+        break;
+      }
+    }
+  }
+
+  return (progress);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// run rounds until all cores are done or no progress can be made.
+// Every thread takes cores from the current round until none is left,
+// then waits for the others before the next round starts.
+// ------------------------------------------------------------------------
+static void * host_worker (void * arg)
+{
+  uint first = (arg == NULL);   // the first thread checks for the end
+
+  while (TRUE)
+  {
+    uint progress = FALSE;
+    uint running  = 0;
+    uint error    = FALSE;
+
+    // run the cores of this round,
+    uint i;
+    while ((i = __atomic_fetch_add (&next_core, 1, __ATOMIC_RELAXED))
+           < num_cores)
+    {
+      host_core_t * c = &cores[i];
+
+      progress |= host_step_core (c);
+      error    |= (c->error != 0);
+      running  += !c->done;
+    }
+
+    if (progress)
+    {
+      __atomic_store_n (&round_progress, TRUE, __ATOMIC_RELAXED);
+    }
+    if (error)
+    {
+      __atomic_store_n (&round_error, TRUE, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch (&round_running, running, __ATOMIC_RELAXED);
+
+    // wait for the round to finish,
+    pthread_barrier_wait (&round_barrier);
+
+    // check if the stage is over and prepare the next round,
+    if (first)
+    {
+      round_cnt++;
+
+      if (round_error)
+      {
+        stage_status = "error";
+      }
+      else if (round_running == 0)
+      {
+        stage_status = "ok";
+      }
+      else if (!round_progress)
+      {
+        report_stuck_cores ();
+        stage_status = "deadlock";
+      }
+
+      next_core      = 0;
+      round_progress = FALSE;
+      round_running  = 0;
+    }
+
+    // and wait for the decision
+    pthread_barrier_wait (&round_barrier);
+
+    if (stage_status != NULL)
+    {
+      break;
+    }
+  }
+
+  host_mail_release ();
+
+  return (NULL);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// run a stage: start (or resume) every core and process packets and
+// callbacks until all cores are done.
+// The order of events does not depend on the number of threads, so
+// runs are fully deterministic.
+// ------------------------------------------------------------------------
+static const char * run_stage (uint * rounds)
+{
+  // (re)start every core,
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+
+    c->done        = FALSE;
+    c->num_tasks   = 0;
+    c->num_recv    = 0;
+    c->num_late    = 0;
+    c->num_sent    = 0;
+    c->num_dropped = 0;
+    memset (c->sent_type, 0, sizeof (c->sent_type));
+    c->round_sent  = 0;
+    c->tx_wait     = 0;
+
+    for (uint p = 0; p < HOST_NUM_PRIORITIES; p++)
+    {
+      c->tasks[p].head = c->tasks[p].tail = 0;
+    }
+
+    if ((stage_id != 0) && (c->resume_fn != NULL))
+    {
+      host_invoke_void (c, c->resume_fn);
+    }
+  }
+
+  // packets sent while starting are delivered in the first round,
+  round_cnt = 1;
+
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+    if (c->start_fn != NULL)
+    {
+      host_invoke_void (c, c->start_fn);
+    }
+  }
+
+  // simulate,
+  round_cnt      = 0;
+  next_core      = 0;
+  round_progress = FALSE;
+  round_running  = 0;
+  round_error    = FALSE;
+  stage_status   = NULL;
+
+  pthread_t * workers = calloc (num_threads, sizeof (pthread_t));
+  for (uint t = 1; t < num_threads; t++)
+  {
+    if (pthread_create (&workers[t], NULL, host_worker,
+                        (void *) (uintptr_t) t) != 0)
+    {
+      host_fail ("cannot create worker thread", NULL);
+    }
+  }
+
+  host_worker (NULL);
+
+  for (uint t = 1; t < num_threads; t++)
+  {
+    pthread_join (workers[t], NULL);
+  }
+  free (workers);
+
+  *rounds = round_cnt;
+
+  // and discard packets that were never delivered
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+    c->num_late += host_mail_take (c, &c->mailbox[0]);
+    c->num_late += host_mail_take (c, &c->mailbox[1]);
+  }
+
+  return (stage_status);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// write recorded channels and report them to the driver
+// ------------------------------------------------------------------------
+static void write_recordings (void)
+{
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+    for (uint ch = 0; ch < HOST_NUM_REC_CHANNS; ch++)
+    {
+      if (c->rec[ch].size == 0)
+      {
+        continue;
+      }
+
+      char name[PATH_MAX];
+      snprintf (name, sizeof (name), "%s/rec_%u_%u.dat", out_dir, i, ch);
+
+      FILE * f = fopen (name, "wb");
+      if (f == NULL)
+      {
+        host_fail ("cannot write recording", name);
+      }
+      fwrite (c->rec[ch].data, 1, c->rec[ch].size, f);
+      fclose (f);
+
+      printf ("rec %u %u %s\n", i, ch, name);
+
+      // recorded data is handed over once
+      c->rec[ch].size = 0;
+    }
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// overwrite the stage configuration region of every core
+// ------------------------------------------------------------------------
+static void set_stage_config (const char * hex)
+{
+  uchar cfg[64];
+  uint len = 0;
+
+  while ((len < sizeof (cfg)) && (sscanf (hex, "%2hhx", &cfg[len]) == 1))
+  {
+    hex += 2;
+    len++;
+  }
+
+  if (len == 0)
+  {
+    return;
+  }
+
+  for (uint i = 0; i < num_cores; i++)
+  {
+    host_core_t * c = &cores[i];
+    if ((c->region[STAGE] != NULL) && (c->region_size[STAGE] >= len))
+    {
+      memcpy (c->region[STAGE], cfg, len);
+    }
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// load graph, then run stages as requested on stdin
+// ------------------------------------------------------------------------
+int main (int argc, char * argv[])
+{
+  int opt;
+  while ((opt = getopt (argc, argv, "vt:r:b:o:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'v':
+        host_verbose = TRUE;
+        break;
+
+      case 't':
+        num_threads = strtoul (optarg, NULL, 0);
+        break;
+
+      case 'r':
+        tx_rate = strtoul (optarg, NULL, 0);
+        break;
+
+      case 'b':
+        bin_dir = optarg;
+        break;
+
+      case 'o':
+        out_dir = optarg;
+        break;
+
+      default:
+        host_fail ("usage: mlp_host [-v] [-t <threads>] [-r <tx rate>] "
+                   "[-b <binaries dir>] [-o <output dir>] <graph file>",
+                   NULL);
+    }
+  }
+
+  if (optind >= argc)
+  {
+    host_fail ("usage: mlp_host [-v] [-t <threads>] [-r <tx rate>] "
+               "[-b <binaries dir>] [-o <output dir>] <graph file>", NULL);
+  }
+
+  // core binaries live next to the simulator by default
+  if (bin_dir == NULL)
+  {
+    static char exe[PATH_MAX];
+    ssize_t n = readlink ("/proc/self/exe", exe, sizeof (exe) - 1);
+    if (n <= 0)
+    {
+      host_fail ("cannot locate core binaries", NULL);
+    }
+    exe[n] = '\0';
+    *strrchr (exe, '/') = '\0';
+    bin_dir = exe;
+  }
+
+  if (num_threads == 0)
+  {
+    num_threads = 1;
+  }
+
+  load_graph (argv[optind]);
+
+  pthread_barrier_init (&round_barrier, NULL, num_threads);
+
+  char line[256];
+  while (fgets (line, sizeof (line), stdin) != NULL)
+  {
+    if (strncmp (line, "quit", 4) == 0)
+    {
+      break;
+    }
+
+    if (strncmp (line, "run", 3) != 0)
+    {
+      fprintf (stderr, "mlp_host: unknown command: %s", line);
+      continue;
+    }
+
+    set_stage_config (line + 3 + strspn (line + 3, " "));
+
+    uint rounds;
+    const char * status = run_stage (&rounds);
+
+    write_recordings ();
+
+    // collect stage statistics from every core,
+    uint tasks = 0, sent = 0, delivered = 0, dropped = 0, late = 0;
+    uint tx_refused = 0, tx_hwm = 0;
+    uint pkt_type[HOST_NUM_PKT_TYPES][2];
+    memset (pkt_type, 0, sizeof (pkt_type));
+
+    for (uint i = 0; i < num_cores; i++)
+    {
+      host_core_t * c = &cores[i];
+
+      tasks     += c->num_tasks;
+      sent      += c->num_sent;
+      delivered += c->num_recv;
+      dropped   += c->num_dropped;
+      late      += c->num_late;
+
+      // report where outbound packets had to be queued,
+      if ((c->tx_refused != NULL) && (*c->tx_refused != 0))
+      {
+        printf ("tx %u %u %u\n", i, *c->tx_refused, *c->tx_hwm);
+        tx_refused += *c->tx_refused;
+        if (*c->tx_hwm > tx_hwm)
+        {
+          tx_hwm = *c->tx_hwm;
+        }
+      }
+
+      for (uint t = 0; t < HOST_NUM_PKT_TYPES; t++)
+      {
+        pkt_type[t][SPINN_FORWARD]  += c->sent_type[t][SPINN_FORWARD];
+        pkt_type[t][SPINN_BACKPROP] += c->sent_type[t][SPINN_BACKPROP];
+      }
+    }
+
+    // and report them
+    printf ("stage %u %s rounds=%u tasks=%u sent=%u delivered=%u "
+            "dropped=%u late=%u tx_refused=%u tx_hwm=%u fwd=%u bkp=%u",
+            stage_id, status, rounds, tasks, sent, delivered, dropped, late,
+            tx_refused, tx_hwm,
+            pkt_type[0][SPINN_FORWARD], pkt_type[0][SPINN_BACKPROP]);
+    for (uint t = 1; t < sizeof (pkt_names) / sizeof (pkt_names[0]); t++)
+    {
+      printf (" %s=%u", pkt_names[t],
+              pkt_type[t][SPINN_FORWARD] + pkt_type[t][SPINN_BACKPROP]);
+    }
+    printf ("\n");
+    fflush (stdout);
+
+    stage_id++;
+  }
+
+  return (EXIT_SUCCESS);
+}
+// ------------------------------------------------------------------------
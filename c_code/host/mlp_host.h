@@ -0,0 +1,173 @@
+#ifndef __MLP_HOST_H__
+#define __MLP_HOST_H__
+
+#include <setjmp.h>
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include "simulation.h"
+
+// ------------------------------------------------------------------------
+// host multicast-fabric simulator
+// ------------------------------------------------------------------------
+// every SpiNNaker core in the machine graph is an instance of one of the
+// MLP core binaries (weight, sum, input or threshold), built as a shared
+// object and loaded privately so that each instance has its own globals.
+// The simulator services the spin1_api calls made by the instances and
+// delivers multicast packets between them according to the routes found
+// in the graph file written by spinn_pdp2/mlp_host.py.
+//
+// The simulation proceeds in rounds. In every round each core receives
+// the packets sent to it in the previous round and then runs its
+// highest-priority scheduled callback to completion. Cores within a round
+// are independent, so a round can be shared by a pool of worker threads:
+// every packet goes through a lock-free mailbox and every batch is
+// delivered in sender order, which makes the results independent of the
+// number of threads. A core is never run by two threads at once, so its
+// callbacks remain atomic with respect to each other, as they are on
+// SpiNNaker, and the *_thrds_pend semaphores need no locking.
+// ------------------------------------------------------------------------
+#define HOST_GRAPH_MAGIC     0x48504c4d   // "MLPH"
+#define HOST_GRAPH_VERSION   1
+
+#define HOST_NUM_REGIONS     12
+#define HOST_NUM_PRIORITIES  8
+#define HOST_NUM_REC_CHANNS  4
+#define HOST_NUM_PKT_TYPES   16
+
+// DTCM available to application data on a SpiNNaker core
+#define HOST_DTCM_SIZE       (64 * 1024)
+
+// single-threaded builds (ARM measurement harness) need no thread storage
+#ifdef HOST_SINGLE_THREAD
+#define HOST_THREAD_LOCAL
+#else
+#define HOST_THREAD_LOCAL    __thread
+#endif
+
+
+// ------------------------------------------------------------------------
+// growable byte buffer (recording channels)
+// ------------------------------------------------------------------------
+typedef struct host_buf
+{
+  uchar * data;
+  uint    size;
+  uint    cap;
+} host_buf_t;
+
+
+// ------------------------------------------------------------------------
+// scheduled callback
+// ------------------------------------------------------------------------
+typedef struct host_task
+{
+  callback_t cback;
+  uint       arg0;
+  uint       arg1;
+} host_task_t;
+
+
+// ------------------------------------------------------------------------
+// FIFO of scheduled callbacks (one per priority level)
+// ------------------------------------------------------------------------
+typedef struct host_task_queue
+{
+  host_task_t * queue;
+  uint          head;
+  uint          tail;
+  uint          cap;
+} host_task_queue_t;
+
+
+// ------------------------------------------------------------------------
+// multicast packet in transit
+// ------------------------------------------------------------------------
+typedef struct host_pkt
+{
+  uint key;
+  uint payload;
+  uint load;
+  uint src;                         // sending core
+  uint seq;                         // send order in the sending core
+} host_pkt_t;
+
+
+// ------------------------------------------------------------------------
+// packet in a core mailbox
+// ------------------------------------------------------------------------
+typedef struct host_mail
+{
+  struct host_mail * next;
+  host_pkt_t         pkt;
+} host_mail_t;
+
+
+// ------------------------------------------------------------------------
+// multicast route: a (key, mask) pair and its destination cores
+// ------------------------------------------------------------------------
+typedef struct host_route
+{
+  uint   key;
+  uint   mask;
+  uint   num_dests;
+  uint * dests;
+} host_route_t;
+
+
+// ------------------------------------------------------------------------
+// simulated core
+// ------------------------------------------------------------------------
+typedef struct host_core
+{
+  uint              id;             // index in the graph file
+  uint              kind;           // SPINN_WEIGHT_PROC, SPINN_SUM_PROC, ...
+  char            * label;          // machine vertex label
+  void            * lib;            // private instance of the core binary
+
+  uint32_t          region_size[HOST_NUM_REGIONS];
+  void            * region[HOST_NUM_REGIONS];
+
+  callback_t        events[NUM_EVENTS];
+  start_callback_t  start_fn;       // simulation start function
+  resume_callback_t resume_fn;      // simulation resume (next stage) function
+
+  host_task_queue_t tasks[HOST_NUM_PRIORITIES];
+
+  host_mail_t     * mailbox[2];     // lock-free MPSC stacks, one per round
+                                    // parity: sent in this / previous round
+  host_pkt_t      * batch;          // packets being delivered (sorted)
+  uint              batch_cap;
+
+  uchar             done;           // stage finished (ready to read)?
+  uint              error;          // rt_error code (0 if none)
+  jmp_buf           abort;          // return point for rt_error
+
+  host_buf_t        rec[HOST_NUM_REC_CHANNS];
+  uint              dtcm_used;      // bytes allocated with spin1_malloc
+
+  uint              num_tasks;      // callbacks executed in this stage
+  uint              num_recv;       // packets delivered in this stage
+  uint              num_late;       // packets arrived after core finished
+  uint              num_sent;       // packets sent in this stage
+  uint              num_dropped;    // packets sent with no route
+  uint              sent_type[HOST_NUM_PKT_TYPES][2]; // by type and phase
+
+  uint              round_sent;     // packets accepted in this round
+  uint              tx_wait;        // send attempts refused in a row
+  uint            * tx_refused;     // core outbound queue statistics
+  uint            * tx_hwm;         // (NULL if not available)
+} host_core_t;
+
+
+// ------------------------------------------------------------------------
+// simulator state shared between the simulator and the spin1 shim
+// ------------------------------------------------------------------------
+extern HOST_THREAD_LOCAL host_core_t * host_cur; // core run by this thread
+
+extern uint host_verbose;           // forward io_printf output?
+
+uint host_route_packet (uint key, uint payload, uint load);
+void host_buf_append (host_buf_t * buf, void const * data, uint size);
+
+#endif
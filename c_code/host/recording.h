@@ -0,0 +1,19 @@
+#ifndef __RECORDING_H__
+#define __RECORDING_H__
+
+// ------------------------------------------------------------------------
+// host replacement for the front-end-common recording interface
+// recorded data is kept per channel and written out at the end of a stage
+// ------------------------------------------------------------------------
+#include "common-typedefs.h"
+
+typedef uint8_t channel_index_t;
+
+bool recording_initialize (void ** recording_data_address,
+                           uint32_t * recording_flags);
+bool recording_record (channel_index_t channel, void * data, uint32_t size);
+void recording_do_step_update (uint32_t time);
+void recording_finalise (void);
+void recording_reset (void);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef __SIMULATION_H__
+#define __SIMULATION_H__
+
+// ------------------------------------------------------------------------
+// host replacement for the front-end-common simulation interface
+// stages are started and resumed by the simulator
+// ------------------------------------------------------------------------
+#include "common-typedefs.h"
+
+typedef void (*start_callback_t) (void);
+typedef void (*resume_callback_t) (void);
+
+bool simulation_steps_initialise (address_t address,
+                                  uint32_t expected_app_magic_number,
+                                  uint32_t * simulation_ticks_pointer,
+                                  uint32_t * infinite_run_pointer,
+                                  uint32_t * time_pointer,
+                                  int sdp_packet_callback_priority,
+                                  int control_packet_callback_priority);
+void simulation_set_start_function (start_callback_t start_function);
+void simulation_handle_pause_resume (resume_callback_t callback);
+void simulation_ready_to_read (void);
+void simulation_run (void);
+
+#endif
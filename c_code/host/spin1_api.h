@@ -0,0 +1,103 @@
+#ifndef __SPIN1_API_H__
+#define __SPIN1_API_H__
+
+// ------------------------------------------------------------------------
+// host (native Linux) replacement for the SpiNNaker spin1_api/sark
+// interface. Only the subset used by the MLP cores is provided.
+// Calls are serviced by the multicast-fabric simulator (mlp_host.c)
+// on behalf of the core instance that is currently running.
+// ------------------------------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// ------------------------------------------------------------------------
+// sark types and constants
+// ------------------------------------------------------------------------
+typedef unsigned int   uint;
+typedef unsigned short ushort;
+typedef unsigned char  uchar;
+
+#ifndef TRUE
+#define TRUE           (0 == 0)
+#define FALSE          (0 != 0)
+#endif
+
+#define IO_BUF         ((char *) 1)
+#define IO_STD         ((char *) 0)
+
+#define RTE_SWERR      7
+
+#define ALLOC_LOCK     1
+
+// io_printf is only used when debugging - send it to stderr
+#define io_printf(stream, ...) \
+  ((void) (stream), host_io_printf (__VA_ARGS__))
+
+// ------------------------------------------------------------------------
+// event and callback definitions
+// ------------------------------------------------------------------------
+#define MC_PACKET_RECEIVED     0
+#define DMA_TRANSFER_DONE      1
+#define TIMER_TICK             2
+#define SDP_PACKET_RX          3
+#define USER_EVENT             4
+#define MCPL_PACKET_RECEIVED   5
+#define NUM_EVENTS             6
+
+#define NO_PAYLOAD             0
+#define WITH_PAYLOAD           1
+
+#define DMA_READ               0
+#define DMA_WRITE              1
+
+typedef void (*callback_t) (uint, uint);
+
+// ------------------------------------------------------------------------
+// hardware registers touched by the cores (timer kick-start)
+// ------------------------------------------------------------------------
+#define VIC_ENABLE     4
+#define TIMER1_INT     4
+#define T1_CONTROL     2
+
+extern volatile uint vic[];
+extern volatile uint tc[];
+
+// ------------------------------------------------------------------------
+// system variables: only the SDRAM heap is used
+// ------------------------------------------------------------------------
+typedef struct heap_t heap_t;
+
+typedef struct sv_t
+{
+  heap_t * sdram_heap;
+} sv_t;
+
+extern sv_t * sv;
+
+// ------------------------------------------------------------------------
+// spin1 API functions
+// ------------------------------------------------------------------------
+void   spin1_callback_on (uint event_id, callback_t cback, int priority);
+uint   spin1_schedule_callback (callback_t cback, uint arg0, uint arg1,
+                                uint priority);
+uint   spin1_send_mc_packet (uint key, uint data, uint load);
+uint   spin1_int_disable (void);
+void   spin1_mode_restore (uint value);
+void   spin1_set_timer_tick (uint time);
+uint   spin1_get_chip_id (void);
+uint   spin1_get_core_id (void);
+void * spin1_malloc (uint bytes);
+void   spin1_memcpy (void * dst, void const * src, uint len);
+uint   spin1_dma_transfer (uint tag, void * system_address,
+                           void * tcm_address, uint direction, uint length);
+
+// ------------------------------------------------------------------------
+// sark functions
+// ------------------------------------------------------------------------
+void * sark_xalloc (heap_t * heap, uint size, uint tag, uint flag);
+void   sark_io_buf_reset (void);
+void   rt_error (uint code, ...);
+void   host_io_printf (const char * fmt, ...);
+
+#endif
@@ -0,0 +1,442 @@
+// host replacements for spin1_api, sark and front-end-common
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include "data_specification.h"
+#include "simulation.h"
+#include "recording.h"
+#include "sqrt.h"
+
+#include "mlp_params.h"
+#include "mlp_host.h"
+
+
+// ------------------------------------------------------------------------
+// host implementation of the SpiNNaker run-time interface
+// every call acts on the core instance pointed to by host_cur
+// ------------------------------------------------------------------------
+// ------------------------------------------------------------------------
+// hardware registers and system variables
+// ------------------------------------------------------------------------
+volatile uint vic[64];
+volatile uint tc[64];
+
+static sv_t host_sv = {NULL};
+sv_t * sv = &host_sv;
+
+// placeholder for regions the python vertices do not write (SYSTEM)
+static uint32_t host_empty_region[32];
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// spin1 API
+// ------------------------------------------------------------------------
+void spin1_callback_on (uint event_id, callback_t cback, int priority)
+{
+  (void) priority;
+
+  if (event_id < NUM_EVENTS)
+  {
+    host_cur->events[event_id] = cback;
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// queue a callback -- callbacks of the same priority run in FIFO order
+// ------------------------------------------------------------------------
+uint spin1_schedule_callback (callback_t cback, uint arg0, uint arg1,
+                              uint priority)
+{
+  if (priority >= HOST_NUM_PRIORITIES)
+  {
+    priority = HOST_NUM_PRIORITIES - 1;
+  }
+
+  host_task_queue_t * q = &host_cur->tasks[priority];
+
+  // grow queue if full,
+  if (q->tail - q->head == q->cap)
+  {
+    uint new_cap = (q->cap == 0) ? 16 : 2 * q->cap;
+    host_task_t * nq = malloc (new_cap * sizeof (host_task_t));
+    for (uint i = 0; i < q->tail - q->head; i++)
+    {
+      nq[i] = q->queue[(q->head + i) % q->cap];
+    }
+    q->tail = q->tail - q->head;
+    q->head = 0;
+    q->cap  = new_cap;
+    free (q->queue);
+    q->queue = nq;
+  }
+
+  // and enqueue callback
+  host_task_t * t = &q->queue[q->tail % q->cap];
+  t->cback = cback;
+  t->arg0  = arg0;
+  t->arg1  = arg1;
+  q->tail++;
+
+  return (TRUE);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// the simulator routes accepted packets immediately -- packets are
+// refused only if it models a congested router (mlp_host -r)
+// ------------------------------------------------------------------------
+uint spin1_send_mc_packet (uint key, uint data, uint load)
+{
+  return (host_route_packet (key, data, load));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// callbacks run to completion on the host, so there is nothing to mask
+// ------------------------------------------------------------------------
+uint spin1_int_disable (void)
+{
+  return (0);
+}
+
+
+void spin1_mode_restore (uint value)
+{
+  (void) value;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// the timer is only used for deadlock detection, which the simulator
+// does itself, so timer ticks are never delivered
+// ------------------------------------------------------------------------
+void spin1_set_timer_tick (uint time)
+{
+  (void) time;
+}
+// ------------------------------------------------------------------------
+
+
+uint spin1_get_chip_id (void)
+{
+  return (host_cur->id >> 4);
+}
+
+
+uint spin1_get_core_id (void)
+{
+  return ((host_cur->id & 0xf) + 1);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// DTCM allocation: zeroed to keep runs deterministic,
+// usage is tracked to flag blocks that would not fit on a core
+// ------------------------------------------------------------------------
+void * spin1_malloc (uint bytes)
+{
+  host_cur->dtcm_used += bytes;
+
+  return (calloc (1, bytes ? bytes : 1));
+}
+// ------------------------------------------------------------------------
+
+
+void spin1_memcpy (void * dst, void const * src, uint len)
+{
+  memcpy (dst, src, len);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// DMA transfers complete immediately: the transfer done callback
+// (if any) runs before spin1_dma_transfer returns
+// ------------------------------------------------------------------------
+uint spin1_dma_transfer (uint tag, void * system_address,
+                         void * tcm_address, uint direction, uint length)
+{
+  static HOST_THREAD_LOCAL uint tid = 0;
+
+  if (direction == DMA_READ)
+  {
+    memcpy (tcm_address, system_address, length);
+  }
+  else
+  {
+    memcpy (system_address, tcm_address, length);
+  }
+
+  // transfer IDs are never 0 (which reports failure)
+  if (++tid == 0)
+  {
+    tid = 1;
+  }
+
+  callback_t cback = host_cur->events[DMA_TRANSFER_DONE];
+  if (cback != NULL)
+  {
+    cback (tid, tag);
+  }
+
+  return (tid);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// sark
+// ------------------------------------------------------------------------
+void * sark_xalloc (heap_t * heap, uint size, uint tag, uint flag)
+{
+  (void) heap;
+  (void) tag;
+  (void) flag;
+
+  return (calloc (1, size ? size : 1));
+}
+
+
+void sark_io_buf_reset (void)
+{
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// run-time error: abandon the current callback and flag the core
+// ------------------------------------------------------------------------
+void rt_error (uint code, ...)
+{
+  host_cur->error = code;
+  host_cur->done  = TRUE;
+
+  longjmp (host_cur->abort, 1);
+}
+// ------------------------------------------------------------------------
+
+
+void host_io_printf (const char * fmt, ...)
+{
+  if (!host_verbose)
+  {
+    return;
+  }
+
+  // format first so that lines from different threads do not mix
+  char buf[256];
+  va_list args;
+  va_start (args, fmt);
+  vsnprintf (buf, sizeof (buf), fmt, args);
+  va_end (args);
+
+  fprintf (stderr, "[%s] %s", host_cur->label, buf);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// data specification: regions come from the graph file
+// ------------------------------------------------------------------------
+data_specification_metadata_t * data_specification_get_data_address (void)
+{
+  return ((data_specification_metadata_t *) host_cur);
+}
+
+
+bool data_specification_read_header (data_specification_metadata_t * ds)
+{
+  return (ds != NULL);
+}
+
+
+void * data_specification_get_region (uint32_t region,
+                                      data_specification_metadata_t * ds)
+{
+  host_core_t * c = (host_core_t *) ds;
+
+  if ((region < HOST_NUM_REGIONS) && (c->region[region] != NULL))
+  {
+    return (c->region[region]);
+  }
+
+  return (host_empty_region);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// simulation interface
+// ------------------------------------------------------------------------
+bool simulation_steps_initialise (address_t address,
+                                  uint32_t expected_app_magic_number,
+                                  uint32_t * simulation_ticks_pointer,
+                                  uint32_t * infinite_run_pointer,
+                                  uint32_t * time_pointer,
+                                  int sdp_packet_callback_priority,
+                                  int control_packet_callback_priority)
+{
+  (void) address;
+  (void) expected_app_magic_number;
+  (void) sdp_packet_callback_priority;
+  (void) control_packet_callback_priority;
+
+  *simulation_ticks_pointer = 0;
+  *infinite_run_pointer = TRUE;
+  *time_pointer = 0;
+
+  return (true);
+}
+
+
+void simulation_set_start_function (start_callback_t start_function)
+{
+  host_cur->start_fn = start_function;
+}
+
+
+void simulation_handle_pause_resume (resume_callback_t callback)
+{
+  host_cur->resume_fn = callback;
+}
+
+
+void simulation_ready_to_read (void)
+{
+  host_cur->done = TRUE;
+}
+
+
+// the simulator runs the event loop -- return to the loader
+void simulation_run (void)
+{
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// recording: every channel is enabled and kept in host memory
+// ------------------------------------------------------------------------
+bool recording_initialize (void ** recording_data_address,
+                           uint32_t * recording_flags)
+{
+  (void) recording_data_address;
+
+  *recording_flags = (1 << HOST_NUM_REC_CHANNS) - 1;
+
+  return (true);
+}
+
+
+bool recording_record (channel_index_t channel, void * data, uint32_t size)
+{
+  if (channel >= HOST_NUM_REC_CHANNS)
+  {
+    return (false);
+  }
+
+  host_buf_append (&host_cur->rec[channel], data, size);
+
+  return (true);
+}
+
+
+void recording_do_step_update (uint32_t time)
+{
+  (void) time;
+}
+
+
+void recording_finalise (void)
+{
+}
+
+
+void recording_reset (void)
+{
+  for (uint ch = 0; ch < HOST_NUM_REC_CHANNS; ch++)
+  {
+    host_cur->rec[ch].size = 0;
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// spinn_common square root support
+// only 64-bit arithmetic is used, so that the code also builds for ARM
+// ------------------------------------------------------------------------
+// (x * y) >> 32 for a 64-bit x and a 32-bit y
+// ------------------------------------------------------------------------
+uint64_t __x_u64_ulr (uint64_t x, uint32_t y)
+{
+  return (((x >> 32) * y) + (((x & 0xffffffff) * y) >> 32));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// 128-bit square of t, as (hi, lo) 64-bit words
+// ------------------------------------------------------------------------
+static void host_square (uint64_t t, uint64_t * hi, uint64_t * lo)
+{
+  uint64_t a = t >> 32;
+  uint64_t b = t & 0xffffffff;
+  uint64_t m = a * b;
+  uint64_t c = m << 33;
+
+  *hi = (a * a) + (m >> 31);
+  *lo = (b * b) + c;
+
+  if (*lo < c)
+  {
+    (*hi)++;
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// reciprocal root estimate for a normalised (msb set) argument u.
+//NOTE: this is not the spinn_common table-driven code: it returns the
+// value for which sqrt_custom's newton_xlr step gives the correctly
+// truncated root, sqrt (2 * u) * 2^47. Results can differ from the board
+// in the last bit of the Doug's momentum learning-rate scale.
+// ------------------------------------------------------------------------
+uint64_t recip_normalized_root (uint32_t u)
+{
+  // t = floor (sqrt (u * 2^95)) bit by bit -- u * 2^95 is (u << 31, 0),
+  uint64_t v = ((uint64_t) u) << 31;
+  uint64_t t = 0;
+
+  for (int b = 63; b >= 0; b--)
+  {
+    uint64_t hi, lo;
+    uint64_t c = t | (((uint64_t) 1) << b);
+
+    host_square (c, &hi, &lo);
+    if ((hi < v) || ((hi == v) && (lo == 0)))
+    {
+      t = c;
+    }
+  }
+
+  // and solve (u << 32) - (ulr (r, u) >> 1) = t for r (rounding up),
+  // dividing d << 32 in two 32-bit steps
+  uint64_t d = 2 * ((((uint64_t) u) << 32) - t);
+  uint64_t q = d / u;
+  uint64_t r = d % u;
+
+  return ((q << 32) + (((r << 32) + u - 1) / u));
+}
+// ------------------------------------------------------------------------
@@ -0,0 +1,11 @@
+#ifndef __SQRT_H__
+#define __SQRT_H__
+
+// ------------------------------------------------------------------------
+// host replacement for the spinn_common square root support
+// recip_normalized_root () and __x_u64_ulr () are provided by spin1_host.c
+// ------------------------------------------------------------------------
+#include <stdint.h>
+#include <assert.h>
+
+#endif
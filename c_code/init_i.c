@@ -12,6 +12,7 @@
 #include "mlp_externs.h"
 #include "init_i.h"
 #include "comms_i.h"
+#include "comms_tx.h"
 
 
 // ------------------------------------------------------------------------
@@ -148,14 +149,25 @@ uint mem_init (void)
     return (SPINN_MEM_UNAVAIL);
   }
 
-  // allocate memory for BACKPROP keys (one per partition)
+  // allocate memory for BACKPROP keys (one per unit)
   if ((i_bkpKey = ((uint *)
-         spin1_malloc (icfg.partitions * sizeof (uint)))) == NULL
+         spin1_malloc (icfg.num_units * sizeof (uint)))) == NULL
      )
   {
     return (SPINN_MEM_UNAVAIL);
   }
 
+  // allocate memory for delta pairs (packed transport only)
+  if (ncfg.packed)
+  {
+    if ((i_pair = ((uchar *)
+           spin1_malloc (icfg.num_units * sizeof (uchar)))) == NULL
+       )
+    {
+      return (SPINN_MEM_UNAVAIL);
+    }
+  }
+
   // allocate memory for INPUT functions
   for (uint i = 0; i < icfg.num_in_procs; i++)
   {
@@ -246,6 +258,18 @@ void var_init (uint reset_examples)
   //NOTE: input cores do not have a tick 0
   tick = SPINN_I_INIT_TICK;
 
+  // initialise event tick and, if the tick stop decisions
+  // are made locally, the number of ticks of the first event
+  ev_tick = SPINN_I_INIT_TICK;
+  if (ncfg.fixed_ticks)
+  {
+    if (ev[event_idx].max_time != SPINN_FP_NaN)
+      max_ticks = SPINN_TIME_TO_TICKS (ev[event_idx].max_time,
+                                       ncfg.ticks_per_int);
+    else
+      max_ticks = SPINN_TIME_TO_TICKS (es->max_time, ncfg.ticks_per_int);
+  }
+
   // initialise network stop flag
   net_stop_rdy = FALSE;
   net_stop = 0;
@@ -260,8 +284,17 @@ void var_init (uint reset_examples)
   if_done = 0;
   ib_done = 0;
 
-  // initialise thread semaphores
-  if_thrds_pend = SPINN_IF_THRDS;
+  // initialise thread semaphores -- the tick stop
+  // decision is made locally if event durations are fixed
+  if (ncfg.fixed_ticks)
+  {
+    if_thrds_init = SPINN_IF_THRDS & ~SPINN_THRD_STOP;
+  }
+  else
+  {
+    if_thrds_init = SPINN_IF_THRDS;
+  }
+  if_thrds_pend = if_thrds_init;
 
   // initialise processing thread flag
   i_active = FALSE;
@@ -274,9 +307,17 @@ void var_init (uint reset_examples)
   //NOTE: colour is initialised to 0.
   fwdKey = rt[FWD] | SPINN_PHASE_KEY(SPINN_FORWARD);
 
-  for (uint p = 0; p < icfg.partitions; p++)
+  // every unit uses the key of its partition (block)
+  for (uint i = 0; i < icfg.num_units; i++)
+  {
+    i_bkpKey[i] = rt[BKPI + (i / icfg.blk_units)]
+                    | SPINN_PHASE_KEY (SPINN_BACKPROP) | i;
+  }
+
+  // packed deltas are paired within their partition
+  if (ncfg.packed)
   {
-    i_bkpKey[p] = rt[BKPI + p] | SPINN_PHASE_KEY (SPINN_BACKPROP);
+    spinn_pair_init (i_pair, icfg.num_units, icfg.blk_units);
   }
 
   // if the INPUT INTEGRATOR is used
@@ -296,6 +337,9 @@ void var_init (uint reset_examples)
     i_net_history[i] = 0;
   }
 
+  // initialise outbound packet queue statistics
+  tx_init ();
+
 #ifdef DEBUG
   // ------------------------------------------------------------------------
   // DEBUG variables
@@ -373,6 +417,9 @@ void stage_done (uint ec, uint key)
   (void) key;
 #endif
 
+  // send any packets left in the outbound queue,
+  tx_flush ();
+
   // pause timer and setup next stage,
   simulation_handle_pause_resume (stage_init);
 
@@ -430,6 +477,13 @@ void stage_done (uint ec, uint key)
   if (wrng_sth) io_printf (IO_BUF, "wrong sth:%d\n", wrng_sth);
 #endif
 
+  // report refused outbound packets -- if any
+  if (tx_refused_cnt)
+  {
+    io_printf (IO_BUF, "tx refused:%u queue high-water:%u\n",
+               tx_refused_cnt, tx_hwm);
+  }
+
 #ifdef DEBUG
   // close log,
   io_printf (IO_BUF, "stopping stage %u\n", xcfg.stage_id);
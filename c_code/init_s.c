@@ -8,9 +8,11 @@
 // mlp
 #include "mlp_params.h"
 #include "mlp_types.h"
+#include "mlp_macros.h"
 #include "mlp_externs.h"
 #include "init_s.h"
 #include "comms_s.h"
+#include "comms_tx.h"
 
 
 // ------------------------------------------------------------------------
@@ -65,6 +67,13 @@ uint cfg_init (void)
   ex = (mlp_example_t *) data_specification_get_region
       (EXAMPLES, data);
 
+  // events -- only needed to make the tick stop decisions locally
+  if (ncfg.fixed_ticks)
+  {
+    ev = (mlp_event_t *) data_specification_get_region
+        (EVENTS, data);
+  }
+
   // routing keys
   rt = (uint *) data_specification_get_region
       (ROUTING, data);
@@ -93,9 +102,11 @@ uint cfg_init (void)
   io_printf (IO_BUF, "te: %d\n", scfg.ldst_expected);
   io_printf (IO_BUF, "uf: %d\n", xcfg.update_function);
   io_printf (IO_BUF, "fg: %d\n", scfg.is_first_group);
+  io_printf (IO_BUF, "tn: %d\n", scfg.is_tree_node);
   io_printf (IO_BUF, "fk: 0x%08x\n", rt[FWD]);
   io_printf (IO_BUF, "bk: 0x%08x\n", rt[BKP]);
   io_printf (IO_BUF, "lk: 0x%08x\n", rt[LDS]);
+  io_printf (IO_BUF, "rk: 0x%08x\n", rt[LDR]);
 #endif
 
   return (SPINN_NO_ERROR);
@@ -161,6 +172,29 @@ uint mem_init (void)
     return (SPINN_MEM_UNAVAIL);
   }
 
+  // allocate memory for net b-d-p batch counts
+  if ((sf_batch[0] = ((scoreboard_t *)
+          spin1_malloc (scfg.num_units * sizeof (scoreboard_t)))) == NULL
+     )
+  {
+    return (SPINN_MEM_UNAVAIL);
+  }
+
+  if ((sf_batch[1] = ((scoreboard_t *)
+          spin1_malloc (scfg.num_units * sizeof (scoreboard_t)))) == NULL
+     )
+  {
+    return (SPINN_MEM_UNAVAIL);
+  }
+
+  // a batch can include every unit in both colours
+  if ((sf_batch_units = ((uint *)
+          spin1_malloc (2 * scfg.num_units * sizeof (uint)))) == NULL
+     )
+  {
+    return (SPINN_MEM_UNAVAIL);
+  }
+
   // allocate memory for received error b-d-ps scoreboards
   if ((sb_arrived[0] = ((scoreboard_t *)
           spin1_malloc (scfg.num_units * sizeof (scoreboard_t)))) == NULL
@@ -211,6 +245,18 @@ void var_init (uint reset_examples)
   //NOTE: SUM cores do not have a tick 0
   tick = SPINN_S_INIT_TICK;
 
+  // initialise event tick and, if the tick stop decisions
+  // are made locally, the number of ticks of the first event
+  ev_tick = SPINN_S_INIT_TICK;
+  if (ncfg.fixed_ticks)
+  {
+    if (ev[event_idx].max_time != SPINN_FP_NaN)
+      max_ticks = SPINN_TIME_TO_TICKS (ev[event_idx].max_time,
+                                       ncfg.ticks_per_int);
+    else
+      max_ticks = SPINN_TIME_TO_TICKS (es->max_time, ncfg.ticks_per_int);
+  }
+
   // initialise network stop flag
   net_stop_rdy = FALSE;
   net_stop = 0;
@@ -224,16 +270,34 @@ void var_init (uint reset_examples)
     s_errors[1][i] = 0;
     sf_arrived[0][i] = 0;
     sf_arrived[1][i] = 0;
+    sf_batch[0][i] = 0;
+    sf_batch[1][i] = 0;
     sb_arrived[0][i] = 0;
     sb_arrived[1][i] = 0;
   }
   sf_done = 0;
+  sf_batch_len = 0;
   sb_done = 0;
   s_ldsa_arrived = 0;
   s_ldst_arrived = 0;
+  s_ldsr_arrived = FALSE;
 
-  // initialise thread semaphores
-  sf_thrds_pend = SPINN_SF_THRDS;
+  // initialise thread semaphores -- tree nodes that expect
+  // no partial nets only wait for the tick stop decision,
+  // which is otherwise made locally if event durations are fixed
+  if (scfg.fwd_expected && ncfg.fixed_ticks)
+  {
+    sf_thrds_init = SPINN_SF_THRDS & ~SPINN_THRD_STOP;
+  }
+  else if (scfg.fwd_expected)
+  {
+    sf_thrds_init = SPINN_SF_THRDS;
+  }
+  else
+  {
+    sf_thrds_init = SPINN_THRD_STOP;
+  }
+  sf_thrds_pend = sf_thrds_init;
   sb_thrds_pend = SPINN_SB_THRDS;
 
   // initialise processing thread flag
@@ -251,9 +315,12 @@ void var_init (uint reset_examples)
   fwdKey  = rt[FWD] | SPINN_PHASE_KEY (SPINN_FORWARD);
   bkpKey  = rt[BKP] | SPINN_PHASE_KEY (SPINN_BACKPROP);
   ldstKey = rt[LDS] | SPINN_LDST_KEY | SPINN_PHASE_KEY (SPINN_BACKPROP);
-  ldsrKey = rt[LDS] | SPINN_LDSR_KEY | SPINN_PHASE_KEY (SPINN_BACKPROP);
+  ldsrKey = rt[LDR] | SPINN_LDSR_KEY | SPINN_PHASE_KEY (SPINN_BACKPROP);
   fdsKey  = rt[FDS] | SPINN_SYNC_KEY | SPINN_PHASE_KEY (SPINN_FORWARD);
 
+  // initialise outbound packet queue statistics
+  tx_init ();
+
 #ifdef DEBUG
   // ------------------------------------------------------------------------
   // DEBUG variables
@@ -272,6 +339,7 @@ void var_init (uint reset_examples)
   ldt_sent = 0;  // total link_delta packets sent
   ldt_recv = 0;  // total link_delta packets received
   ldr_sent = 0;  // link_delta packets sent
+  ldr_recv = 0;  // link_delta packets received
   wrng_phs = 0;  // packets received in wrong phase
   wrng_pth = 0;  // unexpected processing thread
   wrng_cth = 0;  // unexpected comms thread
@@ -336,6 +404,9 @@ void stage_done (uint ec, uint key)
   (void) key;
 #endif
 
+  // send any packets left in the outbound queue,
+  tx_flush ();
+
   // pause timer and setup next stage,
   simulation_handle_pause_resume (stage_init);
 
@@ -393,14 +464,16 @@ void stage_done (uint ec, uint key)
   io_printf (IO_BUF, "recv: fwd:%d bkp:%d\n", recv_fwd, recv_bkp);
   io_printf (IO_BUF, "sent: fwd:%d bkp:%d\n", sent_fwd, sent_bkp);
   io_printf (IO_BUF, "ldsa recv:%d\n", lda_recv);
+  io_printf (IO_BUF, "ldst recv:%d\n", ldt_recv);
   if (scfg.is_first_group)
   {
-    io_printf (IO_BUF, "ldst recv:%d\n", ldt_recv);
     io_printf (IO_BUF, "ldsr sent:%d\n", ldr_sent);
   }
   else
   {
     io_printf (IO_BUF, "ldst sent:%d\n", ldt_sent);
+    io_printf (IO_BUF, "ldsr recv:%d\n", ldr_recv);
+    io_printf (IO_BUF, "ldsr sent:%d\n", ldr_sent);
   }
   io_printf (IO_BUF, "stop recv:%d\n", stp_recv);
   io_printf (IO_BUF, "stpn recv:%d\n", stn_recv);
@@ -411,6 +484,13 @@ void stage_done (uint ec, uint key)
   if (wrng_sth) io_printf (IO_BUF, "wrong sth:%d\n", wrng_sth);
 #endif
 
+  // report refused outbound packets -- if any
+  if (tx_refused_cnt)
+  {
+    io_printf (IO_BUF, "tx refused:%u queue high-water:%u\n",
+               tx_refused_cnt, tx_hwm);
+  }
+
 #ifdef DEBUG
   // close log,
   io_printf (IO_BUF, "stopping stage %u\n", xcfg.stage_id);
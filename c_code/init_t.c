@@ -13,6 +13,8 @@
 #include "mlp_externs.h"
 #include "init_t.h"
 #include "comms_t.h"
+#include "process_t.h"
+#include "comms_tx.h"
 
 
 // ------------------------------------------------------------------------
@@ -168,8 +170,12 @@ uint cfg_init (void)
   io_printf (IO_BUF, "gt: %k\n", tcfg.trn_group_criterion);
   io_printf (IO_BUF, "cf: %d\n", tcfg.criterion_function);
   io_printf (IO_BUF, "fg: %d\n", tcfg.is_first_output_group);
+  io_printf (IO_BUF, "ce: %d\n", tcfg.crit_expected);
   io_printf (IO_BUF, "lg: %d\n", tcfg.is_last_output_group);
   io_printf (IO_BUF, "ef: %d\n", tcfg.error_function);
+  io_printf (IO_BUF, "to: %d\n", tcfg.threshold_only);
+  io_printf (IO_BUF, "mp: %d\n", tcfg.crit_max_part);
+  io_printf (IO_BUF, "be: %d\n", tcfg.bkp_expected);
   io_printf (IO_BUF, "fk: 0x%08x\n", rt[FWD]);
   io_printf (IO_BUF, "bk: 0x%08x\n", rt[BKP]);
   io_printf (IO_BUF, "sk: 0x%08x\n", rt[STP]);
@@ -240,14 +246,25 @@ uint mem_init (void)
     return (SPINN_MEM_UNAVAIL);
   }
 
-  // allocate memory for forward keys (one per partition)
+  // allocate memory for forward keys (one per unit)
   if ((t_fwdKey = ((uint *)
-         spin1_malloc (tcfg.partitions * sizeof (uint)))) == NULL
+         spin1_malloc (tcfg.num_units * sizeof (uint)))) == NULL
      )
   {
     return (SPINN_MEM_UNAVAIL);
   }
 
+  // allocate memory for output pairs (packed transport only)
+  if (ncfg.packed)
+  {
+    if ((t_pair = ((uchar *)
+           spin1_malloc (tcfg.num_units * sizeof (uchar)))) == NULL
+       )
+    {
+      return (SPINN_MEM_UNAVAIL);
+    }
+  }
+
   // allocate memory for OUTPUT functions
   for (uint i = 0; i < tcfg.num_out_procs; i++)
   {
@@ -308,8 +325,29 @@ uint mem_init (void)
 
 
 // ------------------------------------------------------------------------
-// initialise unit outputs and OUTPUT INTEGRATOR state
+// initialise the variables of the max criterion
+// ------------------------------------------------------------------------
+void t_init_max_crit (void)
+{
+  t_max_output_unit = -1;
+  t_max_target_unit = -1;
+  t_max_output = SPINN_SHORT_ACTIV_MIN_POS << (SPINN_ACTIV_SHIFT
+             - SPINN_SHORT_ACTIV_SHIFT);
+  t_max_target = SPINN_SHORT_ACTIV_MIN_POS << (SPINN_ACTIV_SHIFT
+             - SPINN_SHORT_ACTIV_SHIFT);
+
+  // the preceding slices (if any) have not reported yet
+  t_max_prev_output = t_max_output;
+  t_max_prev_target = t_max_target;
+  t_max_prev_same = FALSE;
+  t_max_evaluated = FALSE;
+  t_max_prev_evaluated = FALSE;
+}
 // ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// initialise unit outputs and OUTPUT INTEGRATOR state
 // ------------------------------------------------------------------------
 //NOTE: There is a conflict in the initialisation routine between
 // versions 2.63 and 2.64 of LENS. This function LENS version 2.63.
@@ -488,8 +526,9 @@ void var_init (uint reset_examples, uint reset_epochs_trained)
   net_stop_rdy = FALSE;
   net_stop = 0;
 
-  // initialise max and min ticks
-  if (tcfg.is_last_output_group)
+  // initialise max and min ticks -- needed by every
+  // core if event durations are fixed
+  if (tcfg.is_last_output_group || ncfg.fixed_ticks)
   {
     // get max number of ticks for first event
     if (ev[event_idx].max_time != SPINN_FP_NaN)
@@ -540,8 +579,18 @@ void var_init (uint reset_examples, uint reset_epochs_trained)
   tf_arrived = 0;
   tb_arrived = 0;
 
-  // initialise thread semaphores
-  tf_thrds_pend = SPINN_TF_THRDS;
+  // initialise thread semaphores -- the tick stop decision is
+  // made locally if event durations are fixed, except in
+  // threshold-only groups, which pace their own ticks
+  if (ncfg.fixed_ticks && !tcfg.threshold_only)
+  {
+    tf_thrds_init = SPINN_TF_THRDS & ~SPINN_THRD_STOP;
+  }
+  else
+  {
+    tf_thrds_init = SPINN_TF_THRDS;
+  }
+  tf_thrds_pend = tf_thrds_init;
   tb_thrds_pend = SPINN_TB_THRDS;
 
   // initialise stop function and related flags
@@ -563,24 +612,12 @@ void var_init (uint reset_examples, uint reset_epochs_trained)
     }
 
     // variables for stop criterion computation
-    t_max_output_unit = -1;
-    t_max_target_unit = -1;
-    t_max_output = SPINN_SHORT_ACTIV_MIN_POS << (SPINN_ACTIV_SHIFT
-               - SPINN_SHORT_ACTIV_SHIFT);
-    t_max_target = SPINN_SHORT_ACTIV_MIN_POS << (SPINN_ACTIV_SHIFT
-               - SPINN_SHORT_ACTIV_SHIFT);
-
-    // no need to wait for previous value if first group
-    if (tcfg.is_first_output_group)
-    {
-      tf_init_crit = 1;
-      tf_crit_prev = TRUE;
-    }
-    else
-    {
-      tf_init_crit = 0;
-    }
-    tf_crit_rdy = tf_init_crit;
+    t_init_max_crit ();
+
+    // wait for the criterion values of the children
+    // in the criterion tree and for the local one
+    tf_crit_prev = TRUE;
+    tf_crit_pend = tcfg.crit_expected + 1;
   }
 
   // initialise processing thread flag
@@ -592,17 +629,33 @@ void var_init (uint reset_examples, uint reset_epochs_trained)
 
   // initialise packet keys
   //NOTE: colour is initialised to 0
-  for (uint p = 0; p < tcfg.partitions; p++)
+  // every unit uses the key of its partition (block)
+  for (uint i = 0; i < tcfg.num_units; i++)
   {
-    t_fwdKey[p] = rt[FWDT + p] | SPINN_PHASE_KEY (SPINN_FORWARD);
+    t_fwdKey[i] = rt[FWDT + (i / tcfg.blk_units)]
+                    | SPINN_PHASE_KEY (SPINN_FORWARD) | i;
+  }
+
+  // packed outputs are paired within their partition
+  if (ncfg.packed)
+  {
+    spinn_pair_init (t_pair, tcfg.num_units, tcfg.blk_units);
   }
 
   bkpKey = rt[BKP] | SPINN_PHASE_KEY (SPINN_BACKPROP);
 
   if (tcfg.is_last_output_group)
   {
-    // tick stop key
-    tf_stop_key = rt[STP] | SPINN_STOP_KEY | SPINN_PHASE_KEY (SPINN_FORWARD);
+    // tick stop key -- with fixed event durations it has its own
+    // routes, to the cores that still wait for the tick stop decision
+    if (ncfg.fixed_ticks)
+    {
+      tf_stop_key = rt[TCK] | SPINN_STOP_KEY | SPINN_PHASE_KEY (SPINN_FORWARD);
+    }
+    else
+    {
+      tf_stop_key = rt[STP] | SPINN_STOP_KEY | SPINN_PHASE_KEY (SPINN_FORWARD);
+    }
 
     // network stop key
     tf_stpn_key = rt[STP] | SPINN_STPN_KEY | SPINN_PHASE_KEY (SPINN_FORWARD);
@@ -613,6 +666,9 @@ void var_init (uint reset_examples, uint reset_epochs_trained)
     tf_stop_key = rt[STP] | SPINN_CRIT_KEY | SPINN_PHASE_KEY (SPINN_FORWARD);
   }
 
+  // initialise outbound packet queue statistics
+  tx_init ();
+
 #ifdef DEBUG
   // ------------------------------------------------------------------------
   // DEBUG variables
@@ -688,6 +744,12 @@ void stage_start (void)
   io_printf (IO_BUF, "----------------\n");
   io_printf (IO_BUF, "starting stage %u\n", xcfg.stage_id);
 #endif
+
+  // threshold-only groups receive no nets: start computation
+  if (tcfg.threshold_only)
+  {
+    spin1_schedule_callback (tf_process_tick, 0, 0, SPINN_TF_PROCESS_P);
+  }
 }
 // ------------------------------------------------------------------------
 
@@ -702,6 +764,9 @@ void stage_done (uint ec, uint key)
   (void) key;
 #endif
 
+  // send any packets left in the outbound queue,
+  tx_flush ();
+
   // pause timer and setup next stage,
   simulation_handle_pause_resume (stage_init);
 
@@ -752,7 +817,7 @@ void stage_done (uint ec, uint key)
                   tb_arrived, tcfg.num_units
                 );
       io_printf (IO_BUF, "(tcr:%u fptd:%u bptd:%u)\n",
-                  tf_crit_rdy, tf_thrds_pend, tb_thrds_pend
+                  tf_crit_pend, tf_thrds_pend, tb_thrds_pend
                 );
       io_printf (IO_BUF, "stage aborted\n");
       break;
@@ -767,9 +832,9 @@ void stage_done (uint ec, uint key)
   io_printf (IO_BUF, "total sent:%d\n", pkt_sent);
   io_printf (IO_BUF, "recv: fwd:%d bkp:%d\n", recv_fwd, recv_bkp);
   io_printf (IO_BUF, "sent: fwd:%d bkp:%d\n", sent_fwd, sent_bkp);
-  if (tcfg.is_first_output_group)
+  if (tcfg.crit_expected == 0)
   {
-    io_printf (IO_BUF, "criterion recv: first\n");
+    io_printf (IO_BUF, "criterion recv: leaf\n");
   }
   else
   {
@@ -795,6 +860,13 @@ void stage_done (uint ec, uint key)
   if (wrng_sth) io_printf (IO_BUF, "wrong sth:%d\n", wrng_sth);
 #endif
 
+  // report refused outbound packets -- if any
+  if (tx_refused_cnt)
+  {
+    io_printf (IO_BUF, "tx refused:%u queue high-water:%u\n",
+               tx_refused_cnt, tx_hwm);
+  }
+
 #ifdef DEBUG
   // close log,
   io_printf (IO_BUF, "stopping stage %u\n", xcfg.stage_id);
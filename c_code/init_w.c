@@ -9,9 +9,11 @@
 #include "mlp_params.h"
 #include "mlp_types.h"
 #include "mlp_externs.h"
+#include "mlp_macros.h"
 #include "init_w.h"
 #include "comms_w.h"
 #include "process_w.h"
+#include "comms_tx.h"
 
 
 // ------------------------------------------------------------------------
@@ -58,7 +60,7 @@ uint cfg_init (void)
   // initialise core-specific configuration from SDRAM
   spin1_memcpy (&wcfg, dt, sizeof (w_conf_t));
 
-  // initial connection weights
+  // initial connection weights (short_weight_t if SPINN_WEIGHT_16)
   wt = (weight_t *) data_specification_get_region
       (WEIGHTS, data);
 
@@ -95,9 +97,12 @@ uint cfg_init (void)
   io_printf (IO_BUF, "nc: %d\n", wcfg.num_cols);
   io_printf (IO_BUF, "rb: %d\n", wcfg.row_blk);
   io_printf (IO_BUF, "cb: %d\n", wcfg.col_blk);
+  io_printf (IO_BUF, "rs: %d\n", wcfg.row_base);
+  io_printf (IO_BUF, "cs: %d\n", wcfg.col_base);
   io_printf (IO_BUF, "lr: %k\n", wcfg.learningRate);
   io_printf (IO_BUF, "wd: %k\n", wcfg.weightDecay);
   io_printf (IO_BUF, "mm: %k\n", wcfg.momentum);
+  io_printf (IO_BUF, "be: %d\n", wcfg.bias_en);
   io_printf (IO_BUF, "uf: %d\n", xcfg.update_function);
   io_printf (IO_BUF, "fk: 0x%08x\n", rt[FWD]);
   io_printf (IO_BUF, "bk: 0x%08x\n", rt[BKP]);
@@ -110,45 +115,74 @@ uint cfg_init (void)
 // ------------------------------------------------------------------------
 
 
+// ------------------------------------------------------------------------
+// size in bytes of a block of weights: 16-bit weights are padded
+// to a whole number of words, as blocks are transferred by DMA
+// ------------------------------------------------------------------------
+static uint w_block_bytes (uint size)
+{
+  if (wcfg.weight_format == SPINN_WEIGHT_16)
+  {
+    return (((size * sizeof (short_weight_t)) + 3) & ~3);
+  }
+
+  return (size * sizeof (weight_t));
+}
+// ------------------------------------------------------------------------
+
+
 // ------------------------------------------------------------------------
 // allocate memory in DTCM and SDRAM
 // ------------------------------------------------------------------------
 uint mem_init (void)
 {
+  // the bias weights (if any) are an extra row of the block
+  uint size = (wcfg.num_rows + wcfg.bias_en) * wcfg.num_cols;
+
   // allocate memory for weights
-  if ((w_weights = ((weight_t * *)
-         spin1_malloc (wcfg.num_rows * sizeof (weight_t *)))) == NULL
-     )
+  uint const bytes = w_block_bytes (size);
+  void * wts;
+
+  if ((wts = spin1_malloc (bytes)) == NULL)
   {
     return (SPINN_MEM_UNAVAIL);
   }
 
-  for (uint i = 0; i < wcfg.num_rows; i++)
+#ifdef SPINN_W_DUAL
+  // allocate memory for the BACKPROP copy of the weights
+  void * wts_bp;
+
+  if ((wts_bp = spin1_malloc (bytes)) == NULL)
   {
-    if ((w_weights[i] = ((weight_t *)
-         spin1_malloc (wcfg.num_cols * sizeof (weight_t)))) == NULL
-       )
-    {
     return (SPINN_MEM_UNAVAIL);
-    }
   }
+#else
+  // both phases use the same weights
+  void * wts_bp = wts;
+#endif
 
-  // allocate memory for weight changes
-  if ((w_wchanges = ((long_wchange_t * *)
-         spin1_malloc (wcfg.num_rows * sizeof (long_wchange_t *)))) == NULL
-     )
+  // only the pointers of the selected storage format are used
+  if (wcfg.weight_format == SPINN_WEIGHT_16)
   {
-    return (SPINN_MEM_UNAVAIL);
+    w_sweights    = (short_weight_t *) wts;
+    w_sweights_bp = (short_weight_t *) wts_bp;
+    w_weights     = NULL;
+    w_weights_bp  = NULL;
+  }
+  else
+  {
+    w_weights     = (weight_t *) wts;
+    w_weights_bp  = (weight_t *) wts_bp;
+    w_sweights    = NULL;
+    w_sweights_bp = NULL;
   }
 
-  for (uint i = 0; i < wcfg.num_rows; i++)
+  // allocate memory for weight changes
+  if ((w_wchanges = ((w_wchange_t *)
+         spin1_malloc (size * sizeof (w_wchange_t)))) == NULL
+     )
   {
-    if ((w_wchanges[i] = ((long_wchange_t *)
-         spin1_malloc (wcfg.num_cols * sizeof (long_wchange_t)))) == NULL
-       )
-    {
     return (SPINN_MEM_UNAVAIL);
-    }
   }
 
   // allocate memory for unit outputs
@@ -166,22 +200,35 @@ uint mem_init (void)
     return (SPINN_MEM_UNAVAIL);
   }
 
-  // allocate memory for link deltas
-  if ((w_link_deltas = ((long_delta_t * *)
-         spin1_malloc (wcfg.num_rows * sizeof (long_delta_t *)))) == NULL
+  // allocate memory for running partial nets
+  if ((w_nets[0] = ((long_net_t *)
+         spin1_malloc (wcfg.num_cols * sizeof (long_net_t)))) == NULL
      )
   {
     return (SPINN_MEM_UNAVAIL);
   }
 
-  for (uint i = 0; i < wcfg.num_rows; i++)
+  if ((w_nets[1] = ((long_net_t *)
+         spin1_malloc (wcfg.num_cols * sizeof (long_net_t)))) == NULL
+     )
+  {
+    return (SPINN_MEM_UNAVAIL);
+  }
+
+  // allocate memory for speculative partial nets
+  if ((w_spec_nets = ((net_t *)
+         spin1_malloc (wcfg.num_cols * sizeof (net_t)))) == NULL
+     )
+  {
+    return (SPINN_MEM_UNAVAIL);
+  }
+
+  // allocate memory for link deltas
+  if ((w_link_deltas = ((w_delta_t *)
+         spin1_malloc (size * sizeof (w_delta_t)))) == NULL
+     )
   {
-    if ((w_link_deltas[i] = ((long_delta_t *)
-         spin1_malloc (wcfg.num_cols * sizeof (long_delta_t)))) == NULL
-       )
-    {
     return (SPINN_MEM_UNAVAIL);
-    }
   }
 
   // allocate memory for errors
@@ -228,28 +275,32 @@ uint mem_init (void)
 // ------------------------------------------------------------------------
 void var_init (uint init_weights, uint reset_examples)
 {
-  // initialise weights from SDRAM if requested
+  uint size = (wcfg.num_rows + wcfg.bias_en) * wcfg.num_cols;
+
+  // initialise weights from SDRAM if requested: start a single DMA
+  // transfer, which completes while the rest of the variables are
+  // initialised (see w_dma_done). The SDRAM block is row-major so,
+  // if the arena is column-major, it is staged in the weight changes.
+  // If the DMA queue is full the weights are copied by the core.
   if (init_weights)
   {
-    //NOTE: could use DMA
-    for (uint i = 0; i < wcfg.num_rows; i++)
-    {
-      spin1_memcpy (w_weights[i],
-                     &wt[i * wcfg.num_cols],
-                     wcfg.num_cols * sizeof (weight_t)
-                   );
-    }
-  }
+    w_wts_rdy = FALSE;
+    wf_start_rdy = FALSE;
+
+#ifdef SPINN_W_COL_MAJOR
+    void * dst = (void *) w_wchanges;
+#else
+    void * dst = (wcfg.weight_format == SPINN_WEIGHT_16) ?
+                   (void *) w_sweights : (void *) w_weights;
+#endif
 
-#ifdef DEBUG_WEIGHTS
-  for (uint r = 0; r < wcfg.num_rows; r++)
-  {
-    for (uint c =0; c < wcfg.num_cols; c++)
+    if (!spin1_dma_transfer (0, (void *) wt, dst, DMA_READ,
+                             w_block_bytes (size)))
     {
-      io_printf (IO_BUF, "w[%u][%u]: %k\n", r, c, w_weights[r][c]);
+      spin1_memcpy (dst, (void *) wt, w_block_bytes (size));
+      w_dma_done (0, 0);
     }
   }
-#endif
 
   // reset example index if requested
   //TODO: alternative algorithms for choosing example order!
@@ -287,16 +338,32 @@ void var_init (uint init_weights, uint reset_examples)
   {
     w_outputs[0][i] = wcfg.initOutput;
 
-    for (uint j = 0; j < wcfg.num_cols; j++)
-    {
-      w_link_deltas[i][j] = 0;
-      w_wchanges[i][j] = 0;
-    }
-
     w_errors[i] = 0;
     w_output_history[i] = 0;
   }
 
+  // link deltas and weight changes include the bias row
+  for (uint k = 0; k < size; k++)
+  {
+    w_link_deltas[k] = 0;
+  }
+
+#ifdef SPINN_W_COL_MAJOR
+  // weight changes may be staging the weights (cleared in w_dma_done)
+  if (!init_weights)
+#endif
+  {
+    for (uint k = 0; k < size; k++)
+    {
+      w_wchanges[k] = 0;
+    }
+  }
+
+#ifdef SPINN_W_COMPACT
+  // initialise optimiser state overflow count
+  w_ovf_cnt = 0;
+#endif
+
   // initialise delta scaling factor
   // s15.16
   w_delta_dt = (1 << SPINN_FPREAL_SHIFT) / ncfg.ticks_per_int;
@@ -305,6 +372,14 @@ void var_init (uint init_weights, uint reset_examples)
   wf_procs = 0;
   wf_comms = 1;
 
+  // initial unit outputs were not streamed into the partial nets
+  w_nets_rdy[0] = FALSE;
+  w_nets_rdy[1] = FALSE;
+  wf_stream = FALSE;
+
+  // no speculative partial nets yet
+  wf_spec_rdy = FALSE;
+
   // initialise thread semaphores
   wf_thrds_pend = SPINN_WF_THRDS;
   wb_thrds_pend = SPINN_WB_THRDS; // no link delta sum until last BP tick
@@ -325,12 +400,13 @@ void var_init (uint init_weights, uint reset_examples)
 
   // initialise packet keys
   //NOTE: colour is initialised to 0.
-  fwdKey = rt[FWD] | SPINN_PHASE_KEY(SPINN_FORWARD)
-      | SPINN_BLOCK_KEY(wcfg.col_blk);
-  bkpKey = rt[BKP] | SPINN_PHASE_KEY(SPINN_BACKPROP)
-      | SPINN_BLOCK_KEY(wcfg.row_blk);
+  fwdKey = rt[FWD] | SPINN_PHASE_KEY(SPINN_FORWARD);
+  bkpKey = rt[BKP] | SPINN_PHASE_KEY(SPINN_BACKPROP);
   ldsaKey = rt[LDS] | SPINN_LDSA_KEY | SPINN_PHASE_KEY(SPINN_BACKPROP);
 
+  // initialise outbound packet queue statistics
+  tx_init ();
+
 #ifdef DEBUG
   // ------------------------------------------------------------------------
   // DEBUG variables
@@ -355,6 +431,7 @@ void var_init (uint init_weights, uint reset_examples)
   wrng_pth = 0;  // unexpected processing thread
   wrng_cth = 0;  // unexpected comms thread
   wrng_sth = 0;  // unexpected stop thread
+  spc_drop = 0;  // speculative partial nets discarded
   tot_tick = 0;  // total number of ticks executed
   // ------------------------------------------------------------------------
 #endif
@@ -402,8 +479,120 @@ void stage_start (void)
   io_printf (IO_BUF, "starting stage %u\n", xcfg.stage_id);
 #endif
 
-  // trigger computation, when execution starts
-  spin1_schedule_callback (wf_process, 0, 0, SPINN_WF_PROCESS_P);
+  // access weights flag with interrupts disabled
+  uint cpsr = spin1_int_disable ();
+
+  // trigger computation, when execution starts,
+  if (w_wts_rdy)
+  {
+    spin1_schedule_callback (wf_process, 0, 0, SPINN_WF_PROCESS_P);
+  }
+  else
+  {
+    // or when the weights arrive
+    wf_start_rdy = TRUE;
+  }
+
+  // restore interrupts after flag access
+  spin1_mode_restore (cpsr);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// DMA transfer done callback: initial weights have been loaded
+// ------------------------------------------------------------------------
+void w_dma_done (uint tid, uint tag)
+{
+  (void) tid;
+  (void) tag;
+
+#if defined(SPINN_W_COL_MAJOR) || defined(SPINN_W_DUAL) || defined(DEBUG_WEIGHTS)
+  uint rows = wcfg.num_rows + wcfg.bias_en;
+  uint cols = wcfg.num_cols;
+  uint stride = SPINN_W_STRIDE (rows, cols);
+#endif
+
+#ifdef SPINN_W_COL_MAJOR
+  // transpose the staged weights into the arena,
+  if (wcfg.weight_format == SPINN_WEIGHT_16)
+  {
+    short_weight_t * stage = (short_weight_t *) w_wchanges;
+
+    for (uint i = 0; i < rows; i++)
+    {
+      for (uint j = 0; j < cols; j++)
+      {
+        w_sweights[SPINN_W_INX (i, j, stride)] = stage[(i * cols) + j];
+      }
+    }
+  }
+  else
+  {
+    weight_t * stage = (weight_t *) w_wchanges;
+
+    for (uint i = 0; i < rows; i++)
+    {
+      for (uint j = 0; j < cols; j++)
+      {
+        w_weights[SPINN_W_INX (i, j, stride)] = stage[(i * cols) + j];
+      }
+    }
+  }
+
+  // and release the staging area
+  for (uint k = 0; k < (rows * cols); k++)
+  {
+    w_wchanges[k] = 0;
+  }
+#endif
+
+#ifdef SPINN_W_DUAL
+  // build the BACKPROP copy of the weights
+  uint bp_stride = SPINN_W_BP_STRIDE (rows, cols);
+
+  for (uint i = 0; i < rows; i++)
+  {
+    for (uint j = 0; j < cols; j++)
+    {
+      if (wcfg.weight_format == SPINN_WEIGHT_16)
+      {
+        w_sweights_bp[SPINN_W_BP_INX (i, j, bp_stride)] =
+          w_sweights[SPINN_W_INX (i, j, stride)];
+      }
+      else
+      {
+        w_weights_bp[SPINN_W_BP_INX (i, j, bp_stride)] =
+          w_weights[SPINN_W_INX (i, j, stride)];
+      }
+    }
+  }
+#endif
+
+#ifdef DEBUG_WEIGHTS
+  for (uint r = 0; r < rows; r++)
+  {
+    for (uint c = 0; c < cols; c++)
+    {
+      // 16-bit weights are printed as s16.15
+      weight_t w = (wcfg.weight_format == SPINN_WEIGHT_16) ?
+        ((weight_t) w_sweights[SPINN_W_INX (r, c, stride)]
+          << (SPINN_WEIGHT_SHIFT - SPINN_SHORT_WEIGHT_SHIFT)) :
+        w_weights[SPINN_W_INX (r, c, stride)];
+
+      io_printf (IO_BUF, "w[%u][%u]: %k\n", r, c, w);
+    }
+  }
+#endif
+
+  // flag weights as ready and trigger computation if waiting for them
+  w_wts_rdy = TRUE;
+
+  if (wf_start_rdy)
+  {
+    wf_start_rdy = FALSE;
+    spin1_schedule_callback (wf_process, 0, 0, SPINN_WF_PROCESS_P);
+  }
 }
 // ------------------------------------------------------------------------
 
@@ -418,6 +607,9 @@ void stage_done (uint ec, uint key)
   (void) key;
 #endif
 
+  // send any packets left in the outbound queue,
+  tx_flush ();
+
   // pause timer and setup next stage,
   simulation_handle_pause_resume (stage_init);
 
@@ -482,10 +674,26 @@ void stage_done (uint ec, uint key)
   if (wrng_pth) io_printf (IO_BUF, "wrong pth:%d\n", wrng_pth);
   if (wrng_cth) io_printf (IO_BUF, "wrong cth:%d\n", wrng_cth);
   if (wrng_sth) io_printf (IO_BUF, "wrong sth:%d\n", wrng_sth);
+  if (spc_drop) io_printf (IO_BUF, "spec discarded:%d\n", spc_drop);
   io_printf (IO_BUF, "------\n");
   io_printf (IO_BUF, "weight updates:%d\n", wght_ups);
 #endif
 
+#ifdef SPINN_W_COMPACT
+  // report compact optimiser state overflows -- if any
+  if (w_ovf_cnt)
+  {
+    io_printf (IO_BUF, "optimiser state saturated:%u\n", w_ovf_cnt);
+  }
+#endif
+
+  // report refused outbound packets -- if any
+  if (tx_refused_cnt)
+  {
+    io_printf (IO_BUF, "tx refused:%u queue high-water:%u\n",
+               tx_refused_cnt, tx_hwm);
+  }
+
 #ifdef DEBUG
   // close log,
   io_printf (IO_BUF, "stopping stage %u\n", xcfg.stage_id);
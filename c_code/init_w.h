@@ -4,6 +4,7 @@
 uint cfg_init (void);
 uint mem_init (void);
 void var_init (uint init_weights, uint reset_examples);
+void w_dma_done (uint tid, uint tag);
 
 void stage_init     (void);
 void stage_start    (void);
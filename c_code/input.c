@@ -77,6 +77,7 @@ proc_phase_t phase;        // FORWARD or BACKPROP
 uint         max_ticks;    // maximum number of ticks in current event
 uint         min_ticks;    // minimum number of ticks in current event
 uint         tick;         // current tick in phase
+uint         ev_tick;      // current tick in event
 uchar        tick_stop;    // current tick stop decision
 
 uint         to_epoch   = 0;
@@ -125,13 +126,15 @@ uint             i_it_idx;          // index into current inputs/targets
 // (net processing)
 scoreboard_t     if_done;           // current tick net computation done
 uint             if_thrds_pend;     // thread semaphore
+uint             if_thrds_init;     // thread semaphore initial value
 
 // BACKPROP phase specific
 // (delta processing)
 long_delta_t   * ib_init_delta;     // initial delta value for every tick
 scoreboard_t     ib_done;           // current tick delta computation done
 
-uint           * i_bkpKey;          // i cores have one bkpKey per partition
+uint           * i_bkpKey;          // i cores have one bkpKey per unit
+uchar          * i_pair;            // position of every unit in its pair
 
 // history arrays
 long_net_t     * i_net_history;   //sdram pointer where to store input history
@@ -7,7 +7,7 @@ APP = input
 APP_OUTPUT_DIR = ../binaries/
 
 SOURCE_DIRS = .
-SOURCES = input.c comms_i.c process_i.c init_i.c activation.c
+SOURCES = input.c comms_i.c process_i.c init_i.c comms_tx.c activation.c
 
 LIBRARIES += -lm
 
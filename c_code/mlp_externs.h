@@ -67,10 +67,18 @@ extern address_t      xadr;       // stage configuration SDRAM address
 // list of weight update procedures
 extern weight_update_t const w_update_procs[SPINN_NUM_UPDATE_PROCS];
 
-extern weight_t       * * w_weights;     // connection weights block
-extern long_wchange_t * * w_wchanges;    // accumulated weight changes
+extern weight_t         * w_weights;     // connection weights block
+extern weight_t         * w_weights_bp;  // BACKPROP copy of the weights
+extern short_weight_t   * w_sweights;    // 16-bit connection weights block
+extern short_weight_t   * w_sweights_bp; // BACKPROP copy of the 16-bit weights
+extern w_wchange_t      * w_wchanges;    // accumulated weight changes
 extern activation_t     * w_outputs[2];  // unit outputs for b-d-p
-extern long_delta_t   * * w_link_deltas; // computed link deltas
+extern w_delta_t        * w_link_deltas; // computed link deltas
+extern uchar              w_wts_rdy;     // weights loaded from SDRAM?
+#ifdef SPINN_W_COMPACT
+extern uint               w_ovf_cnt;     // saturated optimiser state stores
+#endif
+extern uchar              wf_start_rdy;  // stage waiting for weights?
 extern error_t          * w_errors;      // computed errors next tick
 extern pkt_queue_t        w_pkt_queue;   // queue to hold received packets
 extern fpreal             w_delta_dt;    // scaling factor for link deltas
@@ -78,6 +86,11 @@ extern lds_t              w_lds_final;   // final link delta sum
 extern scoreboard_t       w_sync_arrived; // keep count of expected sync packets
 extern uint               wf_procs;      // pointer to processing unit outputs
 extern uint               wf_comms;      // pointer to receiving unit outputs
+extern long_net_t       * w_nets[2];     // running partial nets (one per column)
+extern uchar              w_nets_rdy[2]; // partial nets include received outputs?
+extern uchar              wf_stream;     // stream received outputs into nets?
+extern net_t            * w_spec_nets;   // next tick partial nets (speculative)
+extern uchar              wf_spec_rdy;   // speculative partial nets computed?
 extern scoreboard_t       wf_arrived;    // keep count of received unit outputs
 extern uint               wf_thrds_pend; // thread semaphore
 extern uchar              wb_active;     // processing BKP-phase packet queue?
@@ -99,12 +112,17 @@ extern uchar            s_active;      // processing packets from queue?
 extern lds_t            s_lds_part;    // partial link delta sum
 extern scoreboard_t   * sf_arrived[2]; // keep count of expected net b-d-p
 extern scoreboard_t     sf_done;       // current tick net computation done
+extern scoreboard_t   * sf_batch[2];   // net b-d-ps arrived in current batch
+extern uint           * sf_batch_units; // units (and colours) in current batch
+extern uint             sf_batch_len;  // number of units in current batch
 extern uint             sf_thrds_pend; // thread semaphore
+extern uint             sf_thrds_init; // thread semaphore initial value
 extern scoreboard_t   * sb_arrived[2]; // keep count of expected error b-d-p
 extern scoreboard_t     sb_done;       // current tick error computation done
 extern uint             sb_thrds_pend; // thread semaphore
 extern scoreboard_t     s_ldsa_arrived; // keep count of the number of partial link delta sums
 extern scoreboard_t     s_ldst_arrived; // keep count of the number of link delta sum totals
+extern uchar            s_ldsr_arrived; // link delta sum result arrived?
 // ------------------------------------------------------------------------
 
 // ------------------------------------------------------------------------
@@ -124,12 +142,14 @@ extern uchar            i_active;      // processing packets from queue?
 extern uint             i_it_idx;      // index into current inputs/targets
 extern scoreboard_t     if_done;       // current tick net computation done
 extern uint             if_thrds_pend; // thread semaphore
+extern uint             if_thrds_init; // thread semaphore initial value
 extern long_delta_t   * ib_init_delta; // initial delta value for every tick
 extern scoreboard_t     ib_done;       // current tick delta computation done
 extern long_net_t     * i_last_integr_net;   //last INTEGRATOR output value
 extern long_delta_t   * i_last_integr_delta; //last INTEGRATOR delta value
 
-extern uint           * i_bkpKey;      // i cores have one bkpKey per partition
+extern uint           * i_bkpKey;      // i cores have one bkpKey per unit
+extern uchar          * i_pair;        // position of every unit in its pair
 
 // history arrays
 extern long_net_t      * i_net_history; //sdram pointer where to store input history
@@ -159,9 +179,9 @@ extern pkt_queue_t      t_pkt_queue;   // queue to hold received packets
 extern uchar            tf_active;     // processing FWD-phase packet queue?
 extern scoreboard_t     tf_arrived;    // keep count of expected nets
 extern uint             tf_thrds_pend; // thread semaphore
-extern uchar            tf_crit_prev;  // criterion value received
-extern uchar            tf_init_crit;  // criterion init value
-extern uchar            tf_crit_rdy;   // criterion can be forwarded
+extern uint             tf_thrds_init; // thread semaphore initial value
+extern uchar            tf_crit_prev;  // criterion values received
+extern uint             tf_crit_pend;  // criterion values pending (and local)
 extern uchar            tf_stop_crit;  // stop criterion met?
 extern uchar            tf_group_crit;     // stop criterion met for all groups?
 extern uchar            tf_event_crit;     // stop criterion met for all events?
@@ -179,10 +199,16 @@ extern int              t_max_output_unit; // unit with highest output
 extern int              t_max_target_unit; // unit with highest target
 extern activation_t     t_max_output;      // highest output value
 extern activation_t     t_max_target;      // highest target value
+extern activation_t     t_max_prev_output; // highest output of previous slices
+extern activation_t     t_max_prev_target; // highest target of previous slices
+extern uchar            t_max_prev_same;   // both on the same unit?
+extern uchar            t_max_evaluated;   // units evaluated in this tick?
+extern uchar            t_max_prev_evaluated; // and in previous slices?
 extern long_deriv_t   * t_output_deriv;
 extern delta_t        * t_deltas;
 
-extern uint           * t_fwdKey;      // t cores have one fwdKey per partition
+extern uint           * t_fwdKey;      // t cores have one fwdKey per unit
+extern uchar          * t_pair;        // position of every unit in its pair
 
 // history arrays
 extern net_t          * t_net_history;
@@ -224,6 +250,7 @@ extern uint wrng_bph;  // BACKPROP packets received in wrong phase
 extern uint wrng_pth;  // unexpected processing thread
 extern uint wrng_cth;  // unexpected comms thread
 extern uint wrng_sth;  // unexpected stop thread
+extern uint spc_drop;  // speculative partial nets discarded
 #endif
 // ------------------------------------------------------------------------
 
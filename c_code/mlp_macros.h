@@ -15,4 +15,151 @@
 #define ABS(x) (((x) >= 0) ? (x) : -(x))
 // ------------------------------------------------------------------------
 
+// ------------------------------------------------------------------------
+// memory barrier for the received packet queues (pkt_queue_t).
+// Each queue has a single producer (the packet received callback) and a
+// single consumer (the processing thread) on the same core, so the
+// queue is safe without disabling interrupts as long as the compiler
+// does not move the accesses to the packets across the head and tail
+// updates. head and tail are free-running: the queue holds tail - head
+// packets and the slot of index i is (i & <queue length - 1>).
+// ------------------------------------------------------------------------
+#define SPINN_BARRIER() __asm__ __volatile__ ("" : : : "memory")
+// ------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------
+// index of element (i, j) of a weight core block of rows x cols
+// (rows include the bias row, if any). Blocks are single arenas stored
+// row-major, or column-major if SPINN_W_COL_MAJOR is defined.
+// ------------------------------------------------------------------------
+#ifdef SPINN_W_COL_MAJOR
+#define SPINN_W_STRIDE(rows, cols)  (rows)
+#define SPINN_W_INX(i, j, stride)   (((j) * (stride)) + (i))
+#else
+#define SPINN_W_STRIDE(rows, cols)  (cols)
+#define SPINN_W_INX(i, j, stride)   (((i) * (stride)) + (j))
+#endif
+// ------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------
+// index of element (i, j) in the BACKPROP arenas (copy of the weights,
+// weight changes and link deltas). If SPINN_W_DUAL is defined these are
+// column-major, so that the error dot products read them sequentially,
+// while the FORWARD weights stay row-major.
+// ------------------------------------------------------------------------
+#ifdef SPINN_W_DUAL
+#ifdef SPINN_W_COL_MAJOR
+#error "SPINN_W_DUAL requires row-major FORWARD weights"
+#endif
+#define SPINN_W_BP_STRIDE(rows, cols)  (rows)
+#define SPINN_W_BP_INX(i, j, stride)   (((j) * (stride)) + (i))
+#else
+#define SPINN_W_BP_STRIDE(rows, cols)  SPINN_W_STRIDE (rows, cols)
+#define SPINN_W_BP_INX(i, j, stride)   SPINN_W_INX (i, j, stride)
+#endif
+// ------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------
+// 32 x 16-bit multiply keeping the top 32 bits of the 48-bit product
+// (a single SMULWB on the ARM968). Used with 16-bit (SPINN_WEIGHT_16)
+// weights: the result cannot overflow and has SPINN_MULWB_SHIFT
+// fractional bits less than the full product.
+// ------------------------------------------------------------------------
+#define SPINN_MULWB_SHIFT  16
+#define SPINN_MULWB(a, b)  ((int) (((long long) (a) * (short) (b)) \
+                                     >> SPINN_MULWB_SHIFT))
+// ------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------
+// packed transport: build a payload from two 16-bit values and
+// extract them (see packed_t in mlp_types.h)
+// ------------------------------------------------------------------------
+#define SPINN_PACK_PAIR(lo, hi)  (((uint) (ushort) (lo)) \
+                                   | (((uint) (ushort) (hi)) << 16))
+#define SPINN_PAIR_LO(payload)   ((packed_t) ((payload) & 0xffff))
+#define SPINN_PAIR_HI(payload)   ((packed_t) ((payload) >> 16))
+
+// round a fixed-point value with shift fractional bits
+// to a packed value with pshift fractional bits, saturating it
+static inline packed_t spinn_pack (long long value, uint shift, uint pshift)
+{
+  long long tmp = (value + (1LL << (shift - pshift - 1))) >> (shift - pshift);
+
+  if (tmp > SPINN_PACKED_MAX)
+  {
+    return ((packed_t) SPINN_PACKED_MAX);
+  }
+  else if (tmp < SPINN_PACKED_MIN)
+  {
+    return ((packed_t) SPINN_PACKED_MIN);
+  }
+
+  return ((packed_t) tmp);
+}
+
+
+// pair the units of every partition (block) of blk_units units:
+// the last unit of a partition with an odd number of units is alone
+static inline void spinn_pair_init (uchar * pair, uint num_units,
+                                    uint blk_units)
+{
+  uint offset = 0;
+
+  for (uint i = 0; i < num_units; i++)
+  {
+    if (offset & 1)
+    {
+      pair[i] = SPINN_PAIR_SECOND;
+    }
+    else if (((offset + 1) < blk_units) && ((i + 1) < num_units))
+    {
+      pair[i] = SPINN_PAIR_FIRST;
+    }
+    else
+    {
+      pair[i] = SPINN_PAIR_ALONE;
+    }
+
+    if (++offset == blk_units)
+    {
+      offset = 0;
+    }
+  }
+}
+
+
+// record that the value of unit inx is ready and return TRUE if the pair
+// must be sent now, with the key index (first unit of the pair) in first
+static inline uint spinn_pair_ready (uchar * pair, uint inx, uint * first)
+{
+  uchar const pos = pair[inx] & SPINN_PAIR_POS_MASK;
+
+  *first = (pos == SPINN_PAIR_SECOND) ? inx - 1 : inx;
+
+  if (pos == SPINN_PAIR_ALONE)
+  {
+    return (TRUE);
+  }
+
+  // wait for the other unit of the pair,
+  if (!(pair[*first] & SPINN_PAIR_RDY))
+  {
+    pair[*first] |= SPINN_PAIR_RDY;
+    return (FALSE);
+  }
+
+  // or send the pair
+  pair[*first] &= ~SPINN_PAIR_RDY;
+  return (TRUE);
+}
+// ------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------
+// number of ticks in an event time (fixed-point) with tpi ticks per interval
+// ------------------------------------------------------------------------
+#define SPINN_TIME_TO_TICKS(time, tpi) \
+  (((((time) + SPINN_SMALL_VAL) * (tpi)) + (1 << (SPINN_FPREAL_SHIFT - 1))) \
+     >> SPINN_FPREAL_SHIFT)
+// ------------------------------------------------------------------------
+
 #endif
@@ -57,6 +57,12 @@
 #define SPINN_DOUGSMOMENTUM_UPDATE  2
 
 
+// weight core weight storage formats
+//--------------------------
+#define SPINN_WEIGHT_32          0
+#define SPINN_WEIGHT_16          1
+
+
 // ------------------------------------------------------------------------
 // activation function options
 // ------------------------------------------------------------------------
@@ -109,19 +115,34 @@
 #define SPINN_COLOUR_SHIFT   10
 #define SPINN_COLOUR_MASK    (1 << SPINN_COLOUR_SHIFT)
 
-// block management
-#define SPINN_BLOCK_SHIFT    5
-#define SPINN_BLOCK_MASK     ((0xff << SPINN_BLOCK_SHIFT) & 0xff)
-#define SPINN_BLOCK_KEY(p)   (p << SPINN_BLOCK_SHIFT)
-#define SPINN_BLKOUT_MASK    ((1 << SPINN_BLOCK_SHIFT) - 1)
-#define SPINN_BLKDLT_MASK    ((1 << SPINN_BLOCK_SHIFT) - 1)
-
 // packet data masks
+//NOTE: data keys carry the unit index within the group. Blocks are not
+// encoded in the key: every block (partition) of a group has its own
+// routing keys, and weight cores subtract the index of their first
+// row/column, so blocks can have any size.
 #define SPINN_OUTPUT_MASK    0x000000ff
 #define SPINN_NET_MASK       0x000000ff
 #define SPINN_DELTA_MASK     0x000000ff
 #define SPINN_ERROR_MASK     0x000000ff
 #define SPINN_STPD_MASK      0x000000ff
+
+// criterion packets that carry a partial max criterion of a split
+// OUTPUT group: the payload is the highest output or target value of
+// the preceding slices, the SAME bit is set if both are on the
+// same unit and the EVAL bit if any of their units was evaluated in
+// this tick (see max_group_crit)
+#define SPINN_CRIT_MAX_OUT   0x00000002
+#define SPINN_CRIT_MAX_TGT   0x00000004
+#define SPINN_CRIT_SAME_MASK 0x00000001
+#define SPINN_CRIT_MAX_EVAL  0x00000008
+
+// packed transport: position of a unit in its pair (the ready flag
+// is kept by the first unit of the pair), see spinn_pair_ready
+#define SPINN_PAIR_ALONE     0x0
+#define SPINN_PAIR_FIRST     0x1
+#define SPINN_PAIR_SECOND    0x2
+#define SPINN_PAIR_POS_MASK  0x3
+#define SPINN_PAIR_RDY       0x4
 // ------------------------------------------------------------------------
 
 
@@ -140,10 +161,23 @@
 // implementation parameters
 // ------------------------------------------------------------------------
 //TODO: check if sizes are appropriate
+// received packet queues (must be powers of 2)
 #define SPINN_THLD_PQ_LEN    256
 #define SPINN_WEIGHT_PQ_LEN  512
 #define SPINN_SUM_PQ_LEN     2048
 #define SPINN_INPUT_PQ_LEN   512
+
+#define SPINN_THLD_PQ_MASK   (SPINN_THLD_PQ_LEN - 1)
+#define SPINN_WEIGHT_PQ_MASK (SPINN_WEIGHT_PQ_LEN - 1)
+#define SPINN_SUM_PQ_MASK    (SPINN_SUM_PQ_LEN - 1)
+#define SPINN_INPUT_PQ_MASK  (SPINN_INPUT_PQ_LEN - 1)
+
+// packets processed by a sum core before updating its scoreboards
+#define SPINN_S_BATCH_LEN    64
+
+// outbound packet queue (must be a power of 2)
+#define SPINN_TX_QUEUE_LEN   256
+#define SPINN_TX_QUEUE_MASK  (SPINN_TX_QUEUE_LEN - 1)
 // ------------------------------------------------------------------------
 
 
@@ -155,7 +189,7 @@
 #define SPINN_THRD_STOP      ((SPINN_THRD_COMS) << 1)
 #define SPINN_THRD_LDSA      ((SPINN_THRD_STOP) << 1)
 #define SPINN_THRD_LDST      ((SPINN_THRD_LDSA) << 1)
-#define SPINN_THRD_LDSR      (SPINN_THRD_LDSA)
+#define SPINN_THRD_LDSR      ((SPINN_THRD_LDST) << 1)
 
 #define SPINN_WF_THRDS       (SPINN_THRD_PROC | SPINN_THRD_COMS | SPINN_THRD_STOP)
 #define SPINN_WB_THRDS       (SPINN_THRD_PROC)
@@ -174,10 +208,12 @@
 // common non-queueable callbacks
 #define SPINN_PACKET_P      -1
 #define SPINN_TIMER_P        0
+#define SPINN_DMA_P          0
 
 // weight core priorities
 #define SPINN_WF_TICK_P      1
 #define SPINN_WF_PROCESS_P   2
+#define SPINN_WF_SPEC_P      3
 #define SPINN_WB_PROCESS_P   3
 
 // sum core priorities
@@ -191,6 +227,9 @@
 #define SPINN_TB_PROCESS_P   2
 #define SPINN_TF_PROCESS_P   3
 
+// outbound packet queue drain (all cores)
+#define SPINN_TX_P           3
+
 // stage exit function
 #define SPINN_DONE_P         4
 // ------------------------------------------------------------------------
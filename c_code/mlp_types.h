@@ -26,14 +26,18 @@ enum MLPRecordings {
 
 // t cores can have more than one FWD key (due to partitions)
 // i cores can have more than one BKP key (due to partitions)
+// t cores have a separate key for the tick stop of fixed event durations
+// s cores have a separate key for the link delta sum result
 enum MLPKeys {
   FWD  = 0,
   BKP  = 1,
   FDS  = 2,
   STP  = 3,
   LDS  = 4,
-  FWDT = 5,
-  BKPI = 5
+  TCK  = 5,
+  LDR  = 6,
+  FWDT = 7,
+  BKPI = 7
 };
 
 
@@ -42,6 +46,7 @@ enum MLPKeys {
 // --------------------------
 // weights are s16.15
 // long weights are s48.15
+// short weights are s2.13 (weight core SPINN_WEIGHT_16 storage)
 //
 // weight changes are s16.15
 // long weight changes are s48.15
@@ -58,6 +63,14 @@ typedef long long long_wchange_t;   // intermediate connection weight change
 #define SPINN_WEIGHT_POS_EPSILON ((weight_t)  1)
 #define SPINN_WEIGHT_NEG_EPSILON ((weight_t) -1)
 #define SPINN_WEIGHT_ONE         (1 << SPINN_WEIGHT_SHIFT)
+
+typedef short     short_weight_t;   // stored connection weight
+
+#define SPINN_SHORT_WEIGHT_SHIFT       13
+#define SPINN_SHORT_WEIGHT_MAX         ((short_weight_t)  SHRT_MAX)
+#define SPINN_SHORT_WEIGHT_MIN         ((short_weight_t) -SHRT_MAX)
+#define SPINN_SHORT_WEIGHT_POS_EPSILON ((short_weight_t)  1)
+#define SPINN_SHORT_WEIGHT_NEG_EPSILON ((short_weight_t) -1)
 // ------------------------------------------------------------------------
 
 
@@ -169,6 +182,46 @@ typedef long long long_delta_t;     // intermediate error delta
 // ------------------------------------------------------------------------
 
 
+// ------------------------------------------------------------------------
+// weight core optimiser state
+// --------------------------
+// link deltas and weight changes are stored in the long formats or,
+// if SPINN_W_COMPACT is defined, in 32 bits with saturation:
+// compact link deltas are s8.23 and compact weight changes s16.15
+// ------------------------------------------------------------------------
+#ifdef SPINN_W_COMPACT
+typedef delta_t        w_delta_t;        // stored link delta
+typedef wchange_t      w_wchange_t;      // stored weight change
+
+#define SPINN_W_DELTA_SHIFT         SPINN_DELTA_SHIFT
+#else
+typedef long_delta_t   w_delta_t;        // stored link delta
+typedef long_wchange_t w_wchange_t;      // stored weight change
+
+#define SPINN_W_DELTA_SHIFT         SPINN_LONG_DELTA_SHIFT
+#endif
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// packed transport
+// --------------------------
+// if the network packs its packets (ncfg.packed) the unit outputs and
+// deltas sent to the weight cores carry two 16-bit values per payload:
+// the unit addressed by the key in the lower half and the next unit of
+// the same partition (block), if there is one, in the upper half.
+// packed outputs are s1.14
+// packed deltas are s2.13
+// ------------------------------------------------------------------------
+typedef short     packed_t;         // packed output or delta
+
+#define SPINN_PACKED_ACTIV_SHIFT    14
+#define SPINN_PACKED_DELTA_SHIFT    13
+#define SPINN_PACKED_MAX            SHRT_MAX
+#define SPINN_PACKED_MIN            SHRT_MIN
+// ------------------------------------------------------------------------
+
+
 // ------------------------------------------------------------------------
 // link_delta sums
 // --------------------------
@@ -221,6 +274,8 @@ typedef uchar proc_phase_t;     // phase (FORWARD or BACKPROP)
 typedef struct network_conf     // MLP network configuration
 {
   uchar net_type;               // type of neural net
+  uchar packed;                 // two 16-bit values per payload?
+  uchar fixed_ticks;            // event durations known in advance?
   uint  ticks_per_int;          // number of ticks per interval
   uint  global_max_ticks;       // max number of ticks across all the examples
   uint  num_write_blks;         // number of groups that write outputs
@@ -238,6 +293,9 @@ typedef struct network_conf     // MLP network configuration
 // connection weights associated with a single origin group and a single
 // destination group (which can be the same in recurrent networks).
 // Weights are usually associated with the destination group.
+// There are no Bias group cores: the first weight core of every column
+// block keeps the bias weights of its columns as an extra row of its
+// block (row num_rows), and adds them in as the output of a bias unit.
 // weight cores compute unit net (FORWARD phase) and error (BACKPROP phase)
 // block dot-products (b-d-p) and weight updates.
 // ------------------------------------------------------------------------
@@ -247,11 +305,15 @@ typedef struct w_conf             // weight core configuration
   uint         num_cols;          // columns in this core's block
   uint         row_blk;           // this core's row block number
   uint         col_blk;           // this core's column block number
+  uint         row_base;          // slice index of the first row
+  uint         col_base;          // slice index of the first column
   scoreboard_t sync_expected;     // num of expected sync packets
   activation_t initOutput;        // initial value for unit outputs
   short_fpreal learningRate;      // network learning rate
   short_fpreal weightDecay;       // network weight decay
   short_fpreal momentum;          // network momentum
+  uchar        bias_en;           // this core holds the bias weights
+  uchar        weight_format;     // weight storage (SPINN_WEIGHT_32/16)
 } w_conf_t;
 // ------------------------------------------------------------------------
 
@@ -261,6 +323,12 @@ typedef struct w_conf             // weight core configuration
 // ------------------------------------------------------------------------
 // sum cores accumulate accumulate b-d-ps sent by weight cores and
 // compute unit nets (FORWARD phase) and errors (BACKPROP phase)
+//
+// groups with a high fan-in can use a reduction tree of sum cores:
+// tree nodes accumulate the b-d-ps of a subset of the weight cores (or of
+// other tree nodes) and send the partial sums, with their colour, to their
+// parent sum core. Tree nodes send no sync or link delta summation packets
+// and skip a phase if they expect no b-d-ps in it.
 // ------------------------------------------------------------------------
 typedef struct s_conf               // sum core configuration
 {
@@ -270,6 +338,7 @@ typedef struct s_conf               // sum core configuration
   scoreboard_t ldsa_expected;       // num of expected partial link delta sums
   scoreboard_t ldst_expected;       // num of expected link delta sum totals
   uchar        is_first_group;      // is this the first group in the network?
+  uchar        is_tree_node;        // is this a reduction tree node?
 } s_conf_t;
 // ------------------------------------------------------------------------
 
@@ -286,6 +355,7 @@ typedef struct i_conf                // input core configuration
   uchar         input_grp;           // is this an INPUT group?
   uint          num_units;           // this core's number of units
   uint          partitions;          // this groups's number of partitions
+  uint          blk_units;           // units per partition (block)
   uint          num_in_procs;        // number of input (net) comp procedures
   uint          procs_list[SPINN_NUM_IN_PROCS];
   uchar         in_integr_en;        // input INTEGRATOR in use
@@ -305,6 +375,12 @@ typedef struct i_conf                // input core configuration
 // External inputs are also processed by threshold cores in this phase.
 // In the BACKPROP phase, these cores compute the error deltas from the
 // errors computed locally (output groups only) or sent by the sum cores.
+// Threshold-only groups have no weight, sum or input cores: their nets
+// are always zero and they only count the errors sent by the weight cores.
+// The threshold cores of OUTPUT groups form a tree (a daisy chain by
+// default) that AND-reduces the stop criterion every tick: every core
+// waits for the criteria of its children and the root, the last OUTPUT
+// group, broadcasts the tick stop decision.
 // ------------------------------------------------------------------------
 typedef struct t_conf                  // threshold core configuration
 {
@@ -312,6 +388,7 @@ typedef struct t_conf                  // threshold core configuration
   uchar         input_grp;             // is this an INPUT group?
   uint          num_units;             // this core's number of units
   uint          partitions;            // this group's number of partitions
+  uint          blk_units;             // units per partition (block)
   uchar         write_results;         // record test results?
   uchar         write_out;             // record outputs?
   uchar         last_tick_only;        // record only last tick of examples?
@@ -329,6 +406,10 @@ typedef struct t_conf                  // threshold core configuration
   uchar         is_first_output_group; // is this the first of the output groups
   uchar         is_last_output_group;  // is this the last of the output groups
   uchar         error_function;        // error function used for BACKPROP
+  uchar         threshold_only;        // no weight, sum or input cores?
+  uchar         crit_max_part;         // send max criterion to next slice?
+  scoreboard_t  bkp_expected;          // num of expected errors per tick
+  scoreboard_t  crit_expected;         // num of expected criteria per tick
 } t_conf_t;
 // ------------------------------------------------------------------------
 
@@ -342,12 +423,20 @@ typedef struct
 
 typedef struct
 {
-  // enqueue to tail, dequeue from head
-  volatile uint head;     // pointer to queue start
-  volatile uint tail;     // pointer to queue end
+  // enqueue to tail, dequeue from head (see SPINN_BARRIER)
+  volatile uint head;     // packets dequeued (free-running)
+  volatile uint tail;     // packets enqueued (free-running)
   packet_t *    queue;    // pointer to actual queue
 } pkt_queue_t;
 
+
+typedef struct
+{
+  uint key;               // packet key (for routing)
+  uint payload;           // packet payload (optional)
+  uint load;              // WITH_PAYLOAD or NO_PAYLOAD
+} tx_packet_t;
+
 #endif
 
 
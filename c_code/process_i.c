@@ -10,6 +10,7 @@
 #include "init_i.h"
 #include "comms_i.h"
 #include "process_i.h"
+#include "comms_tx.h"
 #include "activation.h"
 
 
@@ -54,7 +55,7 @@ void if_process (uint key, uint payload)
   }
 
   // incorporate net index to the packet key and send,
-  while (!spin1_send_mc_packet ((fwdKey | inx), net_tmp, WITH_PAYLOAD));
+  tx_send ((fwdKey | inx), net_tmp, WITH_PAYLOAD);
 
 #ifdef DEBUG
   pkt_sent++;
@@ -82,7 +83,7 @@ void if_process (uint key, uint payload)
     if (if_thrds_pend == SPINN_THRD_PROC)
     {
       // if done initialise semaphore,
-      if_thrds_pend = SPINN_IF_THRDS;
+      if_thrds_pend = if_thrds_init;
 
       // restore interrupts after flag access,
       spin1_mode_restore (cpsr);
@@ -126,31 +127,60 @@ void ib_process (uint key, uint payload)
 
   compute_in_back (inx);
 
-  // saturate and cast the long deltas before sending
-  long_delta_t delta_tmp = i_deltas[inx]
-                         >> (SPINN_LONG_DELTA_SHIFT - SPINN_DELTA_SHIFT);
-  delta_t delta;
-
-  if (delta_tmp >= (long_delta_t) SPINN_DELTA_MAX)
-  {
-    delta = (delta_t) SPINN_DELTA_MAX;
-  }
-  else if (delta_tmp <= (long_delta_t) SPINN_DELTA_MIN)
+  if (!ncfg.packed)
   {
-    delta = (delta_t) SPINN_DELTA_MIN;
+    // saturate and cast the long deltas before sending
+    long_delta_t delta_tmp = i_deltas[inx]
+                           >> (SPINN_LONG_DELTA_SHIFT - SPINN_DELTA_SHIFT);
+    delta_t delta;
+
+    if (delta_tmp >= (long_delta_t) SPINN_DELTA_MAX)
+    {
+      delta = (delta_t) SPINN_DELTA_MAX;
+    }
+    else if (delta_tmp <= (long_delta_t) SPINN_DELTA_MIN)
+    {
+      delta = (delta_t) SPINN_DELTA_MIN;
+    }
+    else
+    {
+      delta = (delta_t) delta_tmp;
+    }
+
+    // incorporate delta index to the packet key and send,
+    tx_send (i_bkpKey[inx], delta, WITH_PAYLOAD);
+
+#ifdef DEBUG
+    pkt_sent++;
+    sent_bkp++;
+#endif
   }
   else
   {
-    delta = (delta_t) delta_tmp;
-  }
+    // or, if packed, send both deltas of the pair once computed,
+    uint first;
+
+    if (spinn_pair_ready (i_pair, inx, &first))
+    {
+      packed_t lo = spinn_pack (i_deltas[first],
+                                SPINN_LONG_DELTA_SHIFT, SPINN_PACKED_DELTA_SHIFT);
+      packed_t hi = 0;
 
-  // incorporate delta index to the packet key and send,
-  while (!spin1_send_mc_packet ((i_bkpKey[inx >> SPINN_BLOCK_SHIFT] | inx), delta, WITH_PAYLOAD));
+      if (i_pair[first] == SPINN_PAIR_FIRST)
+      {
+        hi = spinn_pack (i_deltas[first + 1],
+                         SPINN_LONG_DELTA_SHIFT, SPINN_PACKED_DELTA_SHIFT);
+      }
+
+      tx_send (i_bkpKey[first], SPINN_PACK_PAIR (lo, hi),
+               WITH_PAYLOAD);
 
 #ifdef DEBUG
-  pkt_sent++;
-  sent_bkp++;
+      pkt_sent++;
+      sent_bkp++;
 #endif
+    }
+  }
 
   // mark delta as done,
   ib_done++;
@@ -182,15 +212,23 @@ void if_advance_tick (void)
   tot_tick++;
 #endif
 
-  // check if end of event
+  // make the tick stop decision if event durations are fixed,
+  if (ncfg.fixed_ticks)
+  {
+    tick_stop = (ev_tick >= max_ticks)
+                  || (tick == ncfg.global_max_ticks - 1);
+  }
+
+  // and check if end of event
   if (tick_stop)
   {
     if_advance_event ();
   }
   else
   {
-    // if not done increment tick
+    // if not done increment ticks
     tick++;
+    ev_tick++;
   }
 }
 // ------------------------------------------------------------------------
@@ -269,8 +307,20 @@ void if_advance_event (void)
       i_it_idx += icfg.num_units;
     }
 
-    // and increment tick
+    // increment tick,
     tick++;
+
+    // and initialise event tick -- if the tick stop decisions
+    // are made locally get the number of ticks of the new event
+    ev_tick = SPINN_I_INIT_TICK;
+    if (ncfg.fixed_ticks)
+    {
+      if (ev[event_idx + evt].max_time != SPINN_FP_NaN)
+        max_ticks = SPINN_TIME_TO_TICKS (ev[event_idx + evt].max_time,
+                                         ncfg.ticks_per_int);
+      else
+        max_ticks = SPINN_TIME_TO_TICKS (es->max_time, ncfg.ticks_per_int);
+    }
   }
 }
 // ------------------------------------------------------------------------
@@ -343,6 +393,18 @@ void i_advance_example (void)
     i_it_idx = ev[event_idx].it_idx * icfg.num_units;
   }
 
+  // initialise event tick and, if the tick stop decisions
+  // are made locally, get the number of ticks of the first event
+  ev_tick = SPINN_I_INIT_TICK;
+  if (ncfg.fixed_ticks)
+  {
+    if (ev[event_idx].max_time != SPINN_FP_NaN)
+      max_ticks = SPINN_TIME_TO_TICKS (ev[event_idx].max_time,
+                                       ncfg.ticks_per_int);
+    else
+      max_ticks = SPINN_TIME_TO_TICKS (es->max_time, ncfg.ticks_per_int);
+  }
+
   // if the input INTEGRATOR is used reset the array of last values
   if (icfg.in_integr_en)
     for (uint i = 0; i < icfg.num_units; i++)
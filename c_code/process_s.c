@@ -10,6 +10,7 @@
 #include "init_s.h"
 #include "comms_s.h"
 #include "process_s.h"
+#include "comms_tx.h"
 #include "activation.h"
 
 
@@ -17,29 +18,11 @@
 // sum core computation routines
 // ------------------------------------------------------------------------
 // ------------------------------------------------------------------------
-// process FORWARD phase: accumulate dot products to produce nets
+// check if all net b-d-ps of a unit have arrived and, if so,
+// send the net and check if all nets are done
 // ------------------------------------------------------------------------
-void sf_process (uint key, uint payload)
+static void sf_net_check (uint clr, uint inx)
 {
-#ifdef DEBUG
-  recv_fwd++;
-  if (phase != SPINN_FORWARD)
-    wrng_phs++;
-#endif
-
-  // get net index: mask out block and phase data,
-  uint inx = key & SPINN_NET_MASK;
-
-  // get error colour: mask out block, phase and net index data,
-  uint clr = (key & SPINN_COLOUR_MASK) >> SPINN_COLOUR_SHIFT;
-
-  // accumulate new net b-d-p,
-  s_nets[clr][inx] += (long_net_t) ((net_t) payload);
-
-  // mark net b-d-p as arrived,
-  sf_arrived[clr][inx]++;
-
-  // and check if dot product complete to compute net
   if (sf_arrived[clr][inx] == scfg.fwd_expected)
   {
     net_t net_tmp;
@@ -58,8 +41,14 @@ void sf_process (uint key, uint payload)
       net_tmp = (net_t) s_nets[clr][inx];
     }
 
-    // incorporate net index to the packet key and send,
-    while (!spin1_send_mc_packet ((fwdKey | inx), net_tmp, WITH_PAYLOAD));
+    // incorporate net index to the packet key -- tree nodes keep
+    // the colour for their parent sum core -- and send,
+    uint key = fwdKey | inx;
+    if (scfg.is_tree_node)
+    {
+      key |= clr << SPINN_COLOUR_SHIFT;
+    }
+    tx_send (key, net_tmp, WITH_PAYLOAD);
 
 #ifdef DEBUG
     pkt_sent++;
@@ -91,7 +80,7 @@ void sf_process (uint key, uint payload)
       if (sf_thrds_pend == SPINN_THRD_PROC)
       {
         // if done initialise semaphore
-        sf_thrds_pend = SPINN_SF_THRDS;
+        sf_thrds_pend = sf_thrds_init;
 
         // restore interrupts after flag access,
         spin1_mode_restore (cpsr);
@@ -113,6 +102,84 @@ void sf_process (uint key, uint payload)
 // ------------------------------------------------------------------------
 
 
+// ------------------------------------------------------------------------
+// process FORWARD phase: accumulate dot products to produce nets
+// ------------------------------------------------------------------------
+void sf_process (uint key, uint payload)
+{
+#ifdef DEBUG
+  recv_fwd++;
+  if (phase != SPINN_FORWARD)
+    wrng_phs++;
+#endif
+
+  // get net index: mask out block and phase data,
+  uint inx = key & SPINN_NET_MASK;
+
+  // get error colour: mask out block, phase and net index data,
+  uint clr = (key & SPINN_COLOUR_MASK) >> SPINN_COLOUR_SHIFT;
+
+  // accumulate new net b-d-p,
+  s_nets[clr][inx] += (long_net_t) ((net_t) payload);
+
+  // mark net b-d-p as arrived,
+  sf_arrived[clr][inx]++;
+
+  // and check if dot product complete to compute net
+  sf_net_check (clr, inx);
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// process FORWARD phase in batches (see s_processQueue):
+// accumulate a net b-d-p and count it in the current batch
+// ------------------------------------------------------------------------
+void sf_batch_add (uint key, uint payload)
+{
+#ifdef DEBUG
+  recv_fwd++;
+  if (phase != SPINN_FORWARD)
+    wrng_phs++;
+#endif
+
+  // get net index and colour,
+  uint inx = key & SPINN_NET_MASK;
+  uint clr = (key & SPINN_COLOUR_MASK) >> SPINN_COLOUR_SHIFT;
+
+  // accumulate new net b-d-p,
+  s_nets[clr][inx] += (long_net_t) ((net_t) payload);
+
+  // and count it -- remembering the units that appear in the batch
+  if (sf_batch[clr][inx]++ == 0)
+  {
+    sf_batch_units[sf_batch_len++] = (clr << SPINN_COLOUR_SHIFT) | inx;
+  }
+}
+
+
+// ------------------------------------------------------------------------
+// update the scoreboards of the units that appear in the current batch,
+// in order of first appearance, and complete their nets -- if done
+// ------------------------------------------------------------------------
+void sf_batch_flush (void)
+{
+  for (uint b = 0; b < sf_batch_len; b++)
+  {
+    uint clr = sf_batch_units[b] >> SPINN_COLOUR_SHIFT;
+    uint inx = sf_batch_units[b] & SPINN_NET_MASK;
+
+    sf_arrived[clr][inx] += sf_batch[clr][inx];
+    sf_batch[clr][inx] = 0;
+
+    sf_net_check (clr, inx);
+  }
+
+  sf_batch_len = 0;
+}
+// ------------------------------------------------------------------------
+
+
 // ------------------------------------------------------------------------
 // process BACKPROP phase: accumulate dot products to produce errors
 // ------------------------------------------------------------------------
@@ -160,8 +227,14 @@ void sb_process (uint key, uint payload)
     }
 */
 
-    // incorporate error index to the packet key and send,
-    while (!spin1_send_mc_packet ((bkpKey | inx), error, WITH_PAYLOAD));
+    // incorporate error index to the packet key -- tree nodes keep
+    // the colour for their parent sum core -- and send,
+    uint key = bkpKey | inx;
+    if (scfg.is_tree_node)
+    {
+      key |= clr << SPINN_COLOUR_SHIFT;
+    }
+    tx_send (key, error, WITH_PAYLOAD);
 
 #ifdef DEBUG
     pkt_sent++;
@@ -199,18 +272,30 @@ void sb_process (uint key, uint payload)
         // to arrive
         //TODO: find a better place to do this calculation
         if (xcfg.update_function == SPINN_DOUGSMOMENTUM_UPDATE
+            && !scfg.is_tree_node
             && example_cnt == (xcfg.num_examples - 1)
             && tick == SPINN_SB_END_TICK + 1)
         {
-          // if this s core relates to the first group in the network, then we
-          // also need to wait for the link delta sum totals
-          if (scfg.is_first_group)
+          //NOTE: the link delta sums may have arrived already (e.g., when
+          // tree nodes delay this tick), so only wait for the missing ones
+          sb_thrds_pend = SPINN_SB_THRDS;
+
+          if (s_ldsa_arrived < scfg.ldsa_expected)
           {
-            sb_thrds_pend = SPINN_SB_THRDS | SPINN_THRD_LDSA | SPINN_THRD_LDST;
+            sb_thrds_pend |= SPINN_THRD_LDSA;
           }
-          else
+
+          // if this s core has children in the link delta summation tree,
+          // then we also need to wait for their link delta sum totals
+          if (s_ldst_arrived < scfg.ldst_expected)
+          {
+            sb_thrds_pend |= SPINN_THRD_LDST;
+          }
+
+          // and, unless it is the root, for the result to relay
+          if (!scfg.is_first_group && !s_ldsr_arrived)
           {
-            sb_thrds_pend = SPINN_SB_THRDS | SPINN_THRD_LDSA;
+            sb_thrds_pend |= SPINN_THRD_LDSR;
           }
         }
 
@@ -248,15 +333,23 @@ void sf_advance_tick (void)
   tot_tick++;
 #endif
 
-  // check if end of event
+  // make the tick stop decision if event durations are fixed,
+  if (ncfg.fixed_ticks)
+  {
+    tick_stop = (ev_tick >= max_ticks)
+                  || (tick == ncfg.global_max_ticks - 1);
+  }
+
+  // and check if end of event
   if (tick_stop)
   {
     sf_advance_event ();
   }
   else
   {
-    // if not done increment tick
+    // if not done increment ticks
     tick++;
+    ev_tick++;
   }
 }
 // ------------------------------------------------------------------------
@@ -309,8 +402,9 @@ void sf_advance_event (void)
   // check if done with example's FORWARD phase
   if ((++evt >= num_events) || (tick == ncfg.global_max_ticks - 1))
   {
-    // check if in training mode
-    if (xcfg.training)
+    // check if in training mode -- tree nodes that expect
+    // no partial errors skip the BACKPROP phase
+    if (xcfg.training && scfg.bkp_expected)
     {
       // move on to BACKPROP phase
       phase = SPINN_BACKPROP;
@@ -326,8 +420,20 @@ void sf_advance_event (void)
   }
   else
   {
-    // if not done increment tick
+    // if not done increment tick,
     tick++;
+
+    // and initialise event tick -- if the tick stop decisions
+    // are made locally get the number of ticks of the new event
+    ev_tick = SPINN_S_INIT_TICK;
+    if (ncfg.fixed_ticks)
+    {
+      if (ev[event_idx + evt].max_time != SPINN_FP_NaN)
+        max_ticks = SPINN_TIME_TO_TICKS (ev[event_idx + evt].max_time,
+                                         ncfg.ticks_per_int);
+      else
+        max_ticks = SPINN_TIME_TO_TICKS (es->max_time, ncfg.ticks_per_int);
+    }
   }
 }
 // ------------------------------------------------------------------------
@@ -392,19 +498,37 @@ void s_advance_example (void)
       s_lds_part = 0;
       s_ldsa_arrived = 0;
       s_ldst_arrived = 0;
+      s_ldsr_arrived = FALSE;
     }
   }
 
   // start from first event for next example,
   evt = 0;
   num_events = ex[example_inx].num_events;
+  event_idx = ex[example_inx].ev_idx;
+
+  // initialise event tick and, if the tick stop decisions
+  // are made locally, get the number of ticks of the first event,
+  ev_tick = SPINN_S_INIT_TICK;
+  if (ncfg.fixed_ticks)
+  {
+    if (ev[event_idx].max_time != SPINN_FP_NaN)
+      max_ticks = SPINN_TIME_TO_TICKS (ev[event_idx].max_time,
+                                       ncfg.ticks_per_int);
+    else
+      max_ticks = SPINN_TIME_TO_TICKS (es->max_time, ncfg.ticks_per_int);
+  }
 
   // and send sync packet to allow next example to start
-  while (!spin1_send_mc_packet (fdsKey, 0, NO_PAYLOAD));
+  // (tree nodes leave it to the root of their tree)
+  if (!scfg.is_tree_node)
+  {
+    tx_send (fdsKey, 0, NO_PAYLOAD);
 
 #ifdef DEBUG
-  pkt_sent++;
-  spk_sent++;
+    pkt_sent++;
+    spk_sent++;
 #endif
+  }
 }
 // ------------------------------------------------------------------------
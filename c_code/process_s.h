@@ -2,6 +2,8 @@
 #define __PROCESS_S_H__
 
 void sf_process (uint key, uint payload);
+void sf_batch_add (uint key, uint payload);
+void sf_batch_flush (void);
 void sb_process (uint key, uint payload);
 
 void sf_advance_tick   (void);
@@ -10,6 +10,7 @@
 #include "init_t.h"
 #include "comms_t.h"
 #include "process_t.h"
+#include "comms_tx.h"
 #include "activation.h"
 
 
@@ -55,20 +56,50 @@ void tf_process (uint key, uint payload)
   }
 
   // send newly computed output to w cores,
-  while (!spin1_send_mc_packet ((t_fwdKey[inx >> SPINN_BLOCK_SHIFT] | inx),
-                                 (uint) t_outputs[inx],
-                                 WITH_PAYLOAD
-                               )
-        );
+  if (!ncfg.packed)
+  {
+    tx_send (t_fwdKey[inx], (uint) t_outputs[inx], WITH_PAYLOAD);
+
+#ifdef DEBUG
+    pkt_sent++;
+    sent_fwd++;
+#endif
+  }
+  else
+  {
+    // or, if packed, send both outputs of the pair once computed,
+    uint first;
+
+    if (spinn_pair_ready (t_pair, inx, &first))
+    {
+      packed_t lo = spinn_pack (t_outputs[first],
+                                SPINN_ACTIV_SHIFT, SPINN_PACKED_ACTIV_SHIFT);
+      packed_t hi = 0;
+
+      if (t_pair[first] == SPINN_PAIR_FIRST)
+      {
+        hi = spinn_pack (t_outputs[first + 1],
+                         SPINN_ACTIV_SHIFT, SPINN_PACKED_ACTIV_SHIFT);
+      }
+
+      tx_send (t_fwdKey[first], SPINN_PACK_PAIR (lo, hi),
+               WITH_PAYLOAD);
 
 #ifdef DEBUG
-  pkt_sent++;
-  sent_fwd++;
+      pkt_sent++;
+      sent_fwd++;
 #endif
+    }
+  }
 
-  // evaluate stop criterion,
+  // evaluate stop criterion -- a group without one never converges,
   if (tcfg.output_grp)
-    tf_stop_func (inx);
+  {
+    if (tf_stop_func != NULL)
+      tf_stop_func (inx);
+    else
+      tf_stop_crit = FALSE;
+  }
 
   // mark net as arrived,
   tf_arrived++;
@@ -96,10 +127,10 @@ void tf_process (uint key, uint payload)
       tf_thrds_pend &= ~SPINN_THRD_PROC;
 
       // check if criterion value can be forwarded
-      if (tf_crit_rdy)
+      if (--tf_crit_pend == 0)
       {
-        // initialise semaphore,
-        tf_crit_rdy = tf_init_crit;
+        // initialise count,
+        tf_crit_pend = tcfg.crit_expected + 1;
 
         // restore interrupts after flag access,
         spin1_mode_restore (cpsr);
@@ -107,9 +138,10 @@ void tf_process (uint key, uint payload)
         // send (criterion/tick stop) packet,
         tf_send_stop ();
 
-        // and advance tick if last group
-        //NOTE: last group does not get a stop decision
-        if (tcfg.is_last_output_group)
+        // and advance tick if last group or if event durations are fixed
+        //NOTE: last group does not get a stop decision and
+        // with fixed event durations the others make it locally
+        if (tcfg.is_last_output_group || ncfg.fixed_ticks)
         {
           //TODO: check if need to schedule or can simply call
           tf_advance_tick ();
@@ -117,10 +149,7 @@ void tf_process (uint key, uint payload)
       }
       else
       {
-        // flag that local value is ready,
-        tf_crit_rdy = 1;
-
-        // and restore interrupts after flag access
+        // restore interrupts after flag access
         spin1_mode_restore (cpsr);
       }
     }
@@ -130,7 +159,7 @@ void tf_process (uint key, uint payload)
       if (tf_thrds_pend == SPINN_THRD_PROC)
       {
         // initialise semaphore,
-        tf_thrds_pend = SPINN_TF_THRDS;
+        tf_thrds_pend = tf_thrds_init;
 
         // restore interrupts after flag access,
         spin1_mode_restore (cpsr);
@@ -153,6 +182,28 @@ void tf_process (uint key, uint payload)
 // ------------------------------------------------------------------------
 
 
+// ------------------------------------------------------------------------
+// process FORWARD-phase tick of a threshold-only group
+// compute all unit outputs from zero nets
+// ------------------------------------------------------------------------
+void tf_process_tick (uint unused0, uint unused1)
+{
+  (void) unused0;
+  (void) unused1;
+
+#ifdef TRACE
+  io_printf (IO_BUF, "tf_process_tick\n");
+#endif
+
+  // no input core sends nets: process a zero net for every unit
+  for (uint inx = 0; inx < tcfg.num_units; inx++)
+  {
+    tf_process (inx, 0);
+  }
+}
+// ------------------------------------------------------------------------
+
+
 // ------------------------------------------------------------------------
 // process BACKPROP-phase tick
 // compute error deltas
@@ -167,8 +218,9 @@ void tb_process (uint unused0, uint unused1)
 #endif
 
   // compute deltas based on pre-computed errors,
+  //NOTE: threshold-only groups have no input core to send deltas to
   //TODO: this needs checking!
-  for (uint inx = 0; inx < tcfg.num_units; inx++)
+  for (uint inx = 0; inx < tcfg.num_units && !tcfg.threshold_only; inx++)
   {
     if (tcfg.output_grp)
     {
@@ -199,7 +251,7 @@ void tb_process (uint unused0, uint unused1)
     restore_output (inx, tick - 1);
 
     // send delta to input core for further processing
-    while (!spin1_send_mc_packet ((bkpKey | inx), (uint) delta, WITH_PAYLOAD));
+    tx_send ((bkpKey | inx), (uint) delta, WITH_PAYLOAD);
 
 #ifdef DEBUG
     pkt_sent++;
@@ -253,7 +305,14 @@ void tf_advance_tick (void)
   tot_tick++;
 #endif
 
-  // check if done with event
+  // make the tick stop decision if event durations are fixed,
+  if (ncfg.fixed_ticks)
+  {
+    tick_stop = (ev_tick >= max_ticks)
+                  || (tick == ncfg.global_max_ticks - 1);
+  }
+
+  // and check if done with event
   if (tick_stop)
   {
     // update event criterion
@@ -268,9 +327,15 @@ void tf_advance_tick (void)
   }
   else
   {
-    // if not done increment ticks
+    // if not done increment ticks,
     tick++;
     ev_tick++;
+
+    // and start next tick -- threshold-only groups receive no nets
+    if (tcfg.threshold_only)
+    {
+      spin1_schedule_callback (tf_process_tick, 0, 0, SPINN_TF_PROCESS_P);
+    }
   }
 }
 // ------------------------------------------------------------------------
@@ -375,42 +440,48 @@ void tf_advance_event (void)
   }
   else
   {
-    // if input or output group update parameters
+    // if input or output group update input/target index,
     if (tcfg.input_grp || tcfg.output_grp)
     {
-      // update input/target index,
       t_it_idx += tcfg.num_units;
+    }
 
-      // and update number of ticks for new event
-      if (tcfg.is_last_output_group)
-      {
-        // maximum
-        if (ev[event_idx + evt].max_time != SPINN_FP_NaN)
-          max_ticks = (((ev[event_idx + evt].max_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
-                         + (1 << (SPINN_FPREAL_SHIFT - 1)))
-                         >> SPINN_FPREAL_SHIFT;
-        else
-          max_ticks = (((es->max_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
-                         + (1 << (SPINN_FPREAL_SHIFT - 1)))
-                         >> SPINN_FPREAL_SHIFT;
-
-        // minimum
-        if (ev[event_idx + evt].min_time != SPINN_FP_NaN)
-          min_ticks = (((ev[event_idx + evt].min_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
-                         + (1 << (SPINN_FPREAL_SHIFT - 1)))
-                         >> SPINN_FPREAL_SHIFT;
-        else
-          min_ticks = (((es->min_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
-                         + (1 << (SPINN_FPREAL_SHIFT - 1)))
-                         >> SPINN_FPREAL_SHIFT;
-      }
+    // update number of ticks for new event -- if event durations
+    // are fixed every core makes the tick stop decision locally
+    if (tcfg.is_last_output_group || ncfg.fixed_ticks)
+    {
+      // maximum
+      if (ev[event_idx + evt].max_time != SPINN_FP_NaN)
+        max_ticks = (((ev[event_idx + evt].max_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
+                       + (1 << (SPINN_FPREAL_SHIFT - 1)))
+                       >> SPINN_FPREAL_SHIFT;
+      else
+        max_ticks = (((es->max_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
+                       + (1 << (SPINN_FPREAL_SHIFT - 1)))
+                       >> SPINN_FPREAL_SHIFT;
+
+      // minimum
+      if (ev[event_idx + evt].min_time != SPINN_FP_NaN)
+        min_ticks = (((ev[event_idx + evt].min_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
+                       + (1 << (SPINN_FPREAL_SHIFT - 1)))
+                       >> SPINN_FPREAL_SHIFT;
+      else
+        min_ticks = (((es->min_time + SPINN_SMALL_VAL) * ncfg.ticks_per_int)
+                       + (1 << (SPINN_FPREAL_SHIFT - 1)))
+                       >> SPINN_FPREAL_SHIFT;
     }
 
     // increment example tick,
     tick++;
 
-    // and initialise event tick
+    // initialise event tick,
     ev_tick = SPINN_T_INIT_TICK;
+
+    // and start next tick -- threshold-only groups receive no nets
+    if (tcfg.threshold_only)
+    {
+      spin1_schedule_callback (tf_process_tick, 0, 0, SPINN_TF_PROCESS_P);
+    }
   }
 }
 // ------------------------------------------------------------------------
@@ -448,9 +519,7 @@ void t_advance_example (void)
       nsd = (!xcfg.training || (epoch >= xcfg.num_epochs)) ? 1 : tf_example_crit;
 
       // broadcast network_stop decision,
-      while (!spin1_send_mc_packet (tf_stpn_key | nsd,
-          0, NO_PAYLOAD)
-          );
+      tx_send (tf_stpn_key | nsd, 0, NO_PAYLOAD);
 
 #ifdef DEBUG
       pkt_sent++;
@@ -533,8 +602,16 @@ void t_advance_example (void)
   // initialise output function outputs,
   t_init_outputs ();
 
-  // and update next event data
-  if (tcfg.is_last_output_group)
+  // start next example -- threshold-only groups receive no nets,
+  //NOTE: wait for the network stop decision at the end of an epoch
+  if (tcfg.threshold_only && !net_stop_rdy && !net_stop)
+  {
+    spin1_schedule_callback (tf_process_tick, 0, 0, SPINN_TF_PROCESS_P);
+  }
+
+  // and update next event data -- needed by every
+  // core if event durations are fixed
+  if (tcfg.is_last_output_group || ncfg.fixed_ticks)
   {
     // update number of ticks for new event,
     // maximum
@@ -967,12 +1044,11 @@ void std_stop_crit (uint inx)
 
 // ------------------------------------------------------------------------
 // evaluation of the "max" convergence criterion
-// for each unit in the output group check if both the output and target values
-// are the maximum in the group and, in this case, if their difference is less
-// or equal than the tcfg.group_criterion value.
-//TODO: this routine needs to be modified to adapt to the case in which the
-// output group is split across multiple cores, as this is a global convergence
-// rule, rather than an individual one, as the standard convergence criterion.
+// for each unit in the output group keep track of the highest output and
+// target values. The criterion is met if both are on the same unit and their
+// difference is less than the tcfg.group_criterion value. This is a global
+// rule, rather than an individual one, so it is evaluated once all units of
+// the group have arrived (see max_group_crit).
 // ------------------------------------------------------------------------
 void max_stop_crit (uint inx)
 {
@@ -983,6 +1059,8 @@ void max_stop_crit (uint inx)
   // evaluate only if target is not NaN
   if (tt[t_it_idx + inx] != SPINN_ACTIV_NaN)
   {
+    t_max_evaluated = TRUE;
+
     if (t_outputs[inx] > t_max_output)
     {
       t_max_output = t_outputs[inx];
@@ -994,19 +1072,89 @@ void max_stop_crit (uint inx)
       t_max_target = tt[t_it_idx + inx];
       t_max_target_unit = inx;
     }
+  }
+}
+// ------------------------------------------------------------------------
 
-    error_t error = (error_t) ABS ((t_max_output - t_max_target) >>
-                        (SPINN_ACTIV_SHIFT - SPINN_ERROR_SHIFT));
 
-    if ((t_max_output_unit == -1)
-         || ((t_max_output_unit == t_max_target_unit)
-             && (error < t_group_criterion)
-            )
-       )
-      tf_stop_crit = TRUE;
-    else
-      tf_stop_crit = FALSE;
+// ------------------------------------------------------------------------
+// combine the highest output and target values of this slice of the output
+// group with those of the preceding slices, which win ties (their units come
+// first). Every slice but the last passes the result on to the next slice,
+// and the last one evaluates the "max" convergence criterion on it.
+//NOTE: the maxima are kept across ticks -- they are only initialised with
+// the rest of the stage variables -- so the combined values are not stored.
+// The criterion is met by default if no unit was evaluated in this tick.
+// ------------------------------------------------------------------------
+uchar max_group_crit (void)
+{
+#ifdef TRACE
+  io_printf (IO_BUF, "max_group_crit\n");
+#endif
+
+  activation_t max_output = t_max_output;
+  activation_t max_target = t_max_target;
+  uchar evaluated = t_max_evaluated || t_max_prev_evaluated;
+
+  // check if highest output and target are on the same unit of this slice,
+  uchar same = (t_max_output_unit != -1)
+                 && (t_max_output_unit == t_max_target_unit);
+
+  // combine with the preceding slices -- they are on the same unit
+  // only if both maxima come from the same side,
+  uchar out_prev = (t_max_prev_output >= max_output);
+  uchar tgt_prev = (t_max_prev_target >= max_target);
+
+  if (out_prev)
+  {
+    max_output = t_max_prev_output;
+  }
+
+  if (tgt_prev)
+  {
+    max_target = t_max_prev_target;
+  }
+
+  if (out_prev != tgt_prev)
+  {
+    same = FALSE;
+  }
+  else if (out_prev)
+  {
+    same = t_max_prev_same;
+  }
+
+  // wait for units to be evaluated in the next tick
+  t_max_evaluated = FALSE;
+
+  if (tcfg.crit_max_part)
+  {
+    // pass the partial result on to the next slice,
+    uint key = tf_stop_key | (same ? SPINN_CRIT_SAME_MASK : 0)
+                 | (evaluated ? SPINN_CRIT_MAX_EVAL : 0);
+    tx_send (key | SPINN_CRIT_MAX_OUT, (uint) max_output, WITH_PAYLOAD);
+    tx_send (key | SPINN_CRIT_MAX_TGT, (uint) max_target, WITH_PAYLOAD);
+
+#ifdef DEBUG
+    pkt_sent += 2;
+    crt_sent += 2;
+#endif
+
+    return (TRUE);
+  }
+
+  if (!evaluated)
+  {
+    return (TRUE);
   }
+
+  // or evaluate the criterion -- met if no output is above the minimum,
+  error_t error = (error_t) ABS ((max_output - max_target) >>
+                      (SPINN_ACTIV_SHIFT - SPINN_ERROR_SHIFT));
+
+  return ((max_output == (SPINN_SHORT_ACTIV_MIN_POS << (SPINN_ACTIV_SHIFT
+                            - SPINN_SHORT_ACTIV_SHIFT)))
+            || (same && (error < t_group_criterion)));
 }
 // ------------------------------------------------------------------------
 
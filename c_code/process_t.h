@@ -2,6 +2,7 @@
 #define __PROCESS_T_H__
 
 void tf_process (uint key,     uint payload);
+void tf_process_tick (uint unused0, uint unused1);
 void tb_process (uint unused0, uint unused1);
 
 void tf_advance_tick   (void);
@@ -27,6 +28,7 @@ void out_bias_back       (uint inx);
 
 void std_stop_crit       (uint inx);
 void max_stop_crit       (uint inx);
+uchar max_group_crit     (void);
 
 void error_cross_entropy (uint inx);
 void error_squared       (uint inx);
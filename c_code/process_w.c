@@ -10,15 +10,238 @@
 #include "init_w.h"
 #include "comms_w.h"
 #include "process_w.h"
+#include "comms_tx.h"
 #include "activation.h"
 
 
 // ------------------------------------------------------------------------
 // weight core computation routines
 // ------------------------------------------------------------------------
+// ------------------------------------------------------------------------
+// store link deltas and weight changes: compact (32-bit) state saturates
+// and counts the overflows in ovf (added to w_ovf_cnt by w_add_ovf)
+// ------------------------------------------------------------------------
+static inline w_delta_t w_sat_delta (long_delta_t d, uint * ovf)
+{
+#ifdef SPINN_W_COMPACT
+  if (d > (long_delta_t) SPINN_DELTA_MAX)
+  {
+    (*ovf)++;
+    return ((w_delta_t) SPINN_DELTA_MAX);
+  }
+  else if (d < (long_delta_t) SPINN_DELTA_MIN)
+  {
+    (*ovf)++;
+    return ((w_delta_t) SPINN_DELTA_MIN);
+  }
+#else
+  (void) ovf;
+#endif
+
+  return ((w_delta_t) d);
+}
+
+
+static inline w_wchange_t w_sat_wchange (long_wchange_t c, uint * ovf)
+{
+#ifdef SPINN_W_COMPACT
+  if (c > (long_wchange_t) INT_MAX)
+  {
+    (*ovf)++;
+    return ((w_wchange_t) INT_MAX);
+  }
+  else if (c < (long_wchange_t) INT_MIN)
+  {
+    (*ovf)++;
+    return ((w_wchange_t) INT_MIN);
+  }
+#else
+  (void) ovf;
+#endif
+
+  return ((w_wchange_t) c);
+}
+
+
+static inline void w_add_ovf (uint ovf)
+{
+#ifdef SPINN_W_COMPACT
+  w_ovf_cnt += ovf;
+#else
+  (void) ovf;
+#endif
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// read and write the BACKPROP weights in either storage format: 16-bit
+// weights (SPINN_WEIGHT_16) are widened to s16.15 when read, and new
+// weights are rounded to s2.13 before they are saturated
+// ------------------------------------------------------------------------
+static inline weight_t w_get_weight_bp (uint k, uchar wt_short)
+{
+  if (wt_short)
+  {
+    return ((weight_t) w_sweights_bp[k]
+             << (SPINN_WEIGHT_SHIFT - SPINN_SHORT_WEIGHT_SHIFT));
+  }
+
+  return (w_weights_bp[k]);
+}
+
+
+static inline void w_put_weight_bp (uint k, weight_t weight,
+                                    long_weight_t temp, uchar wt_short)
+{
+  if (wt_short)
+  {
+    // round to the storage format,
+    temp = (temp + (1 << (SPINN_WEIGHT_SHIFT - SPINN_SHORT_WEIGHT_SHIFT - 1)))
+             >> (SPINN_WEIGHT_SHIFT - SPINN_SHORT_WEIGHT_SHIFT);
+
+    // saturate new weight,
+    if (temp >= (long_weight_t) SPINN_SHORT_WEIGHT_MAX)
+    {
+      w_sweights_bp[k] = SPINN_SHORT_WEIGHT_MAX;
+    }
+    else if (temp <= (long_weight_t) SPINN_SHORT_WEIGHT_MIN)
+    {
+      w_sweights_bp[k] = SPINN_SHORT_WEIGHT_MIN;
+    }
+    // and avoid (new weight == 0) -- indicates no connection!
+    else if (temp == 0)
+    {
+      if (weight > 0)
+      {
+        w_sweights_bp[k] = SPINN_SHORT_WEIGHT_POS_EPSILON;
+      }
+      else
+      {
+        w_sweights_bp[k] = SPINN_SHORT_WEIGHT_NEG_EPSILON;
+      }
+    }
+    else
+    {
+      w_sweights_bp[k] = (short_weight_t) temp;
+    }
+
+    return;
+  }
+
+  // saturate new weight,
+  if (temp >= (long_weight_t) SPINN_WEIGHT_MAX)
+  {
+    w_weights_bp[k] = SPINN_WEIGHT_MAX;
+  }
+  else if (temp <= (long_weight_t) SPINN_WEIGHT_MIN)
+  {
+    w_weights_bp[k] = SPINN_WEIGHT_MIN;
+  }
+  // and avoid (new weight == 0) -- indicates no connection!
+  else if (temp == 0)
+  {
+    if (weight > 0)
+    {
+      w_weights_bp[k] = SPINN_WEIGHT_POS_EPSILON;
+    }
+    else
+    {
+      w_weights_bp[k] = SPINN_WEIGHT_NEG_EPSILON;
+    }
+  }
+  else
+  {
+    w_weights_bp[k] = (weight_t) temp;
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// bias contribution to the partial net of column j
+// (the bias unit output is always one)
+// ------------------------------------------------------------------------
+static inline long_net_t w_bias_net (uint j, uint stride)
+{
+  if (!wcfg.bias_en)
+  {
+    return (0);
+  }
+
+  if (wcfg.weight_format == SPINN_WEIGHT_16)
+  {
+    return ((long_net_t) w_sweights[SPINN_W_INX (wcfg.num_rows, j, stride)]
+             << (SPINN_LONG_NET_SHIFT - SPINN_SHORT_WEIGHT_SHIFT));
+  }
+
+  return ((long_net_t) w_weights[SPINN_W_INX (wcfg.num_rows, j, stride)]
+           << (SPINN_LONG_NET_SHIFT - SPINN_WEIGHT_SHIFT));
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// partial dot product (output * weight) of column j for the given set of
+// unit outputs - taken from the streamed partial net, if available,
+// or computed in full, and saturated to a net
+// ------------------------------------------------------------------------
+static net_t wf_net_part (uint outs, uint j, uint stride)
+{
+  long_net_t net_part_tmp;
+
+  if (w_nets_rdy[outs])
+  {
+    // use the streamed partial net,
+    net_part_tmp = w_nets[outs][j];
+  }
+  else
+  {
+    // or compute it, starting from the bias weight
+    net_part_tmp = w_bias_net (j, stride);
+
+    if (wcfg.weight_format == SPINN_WEIGHT_16)
+    {
+      // 16-bit weights need only 32 x 16-bit products
+      for (uint i = 0; i < wcfg.num_rows; i++)
+      {
+        net_part_tmp += (SPINN_MULWB (w_outputs[outs][i],
+                           w_sweights[SPINN_W_INX (i, j, stride)])
+                  >> (SPINN_ACTIV_SHIFT + SPINN_SHORT_WEIGHT_SHIFT
+                      - SPINN_MULWB_SHIFT - SPINN_LONG_NET_SHIFT));
+      }
+    }
+    else
+    {
+      for (uint i = 0; i < wcfg.num_rows; i++)
+      {
+        net_part_tmp += (((long_net_t) w_outputs[outs][i]
+                           * (long_net_t) w_weights[SPINN_W_INX (i, j, stride)])
+                    >> (SPINN_ACTIV_SHIFT + SPINN_WEIGHT_SHIFT - SPINN_LONG_NET_SHIFT));
+      }
+    }
+  }
+
+  // saturate the value computed
+  if (net_part_tmp > (long_net_t) SPINN_NET_MAX)
+    // positive saturation
+    return ((net_t) SPINN_NET_MAX);
+  else if (net_part_tmp < (long_net_t) SPINN_NET_MIN)
+    // negative saturation
+    return ((net_t) SPINN_NET_MIN);
+  else
+    // no saturation needed
+    return ((net_t) net_part_tmp);
+}
+// ------------------------------------------------------------------------
+
+
 // ------------------------------------------------------------------------
 // process a FORWARD-phase tick
-// compute partial dot products (output * weight)
+// send the partial dot products (output * weight) - these are streamed
+// as the unit outputs arrive (see w_forward_packet) and computed here
+// only for outputs that were not streamed, unless they were computed
+// while waiting for the tick stop decision (see wf_speculate)
 // ------------------------------------------------------------------------
 void wf_process (uint unused0, uint unused1)
 {
@@ -29,32 +252,36 @@ void wf_process (uint unused0, uint unused1)
   io_printf (IO_BUF, "wf_process\n");
 #endif
 
-  // compute all net block dot-products and send them for accumulation,
-  for (uint j = 0; j < wcfg.num_cols; j++)
+  // access streaming flag with interrupts disabled
+  uint cpsr = spin1_int_disable ();
+
+  // weights are fixed until the end of the example: start streaming,
+  //NOTE: outputs received before this point are processed in full
+  if (!wf_stream)
   {
-    long_net_t net_part_tmp = 0;
+    wf_stream = TRUE;
 
-    for (uint i = 0; i < wcfg.num_rows; i++)
+    if (w_nets_rdy[wf_comms])
     {
-      net_part_tmp += (((long_net_t) w_outputs[wf_procs][i] * (long_net_t) w_weights[i][j])
-                  >> (SPINN_ACTIV_SHIFT + SPINN_WEIGHT_SHIFT - SPINN_LONG_NET_SHIFT));
+      wf_init_nets (wf_comms);
     }
+  }
 
-    net_t net_part = 0;
+  // restore interrupts after flag access
+  spin1_mode_restore (cpsr);
 
-    // saturate the value computed and assign it to the net_part variable
-    if (net_part_tmp > (long_net_t) SPINN_NET_MAX)
-      // positive saturation
-      net_part = (net_t) SPINN_NET_MAX;
-    else if (net_part_tmp < (long_net_t) SPINN_NET_MIN)
-      // negative saturation
-      net_part = (net_t) SPINN_NET_MIN;
-    else
-      // no saturation needed
-      net_part = (net_t) net_part_tmp;
+  uint const stride = SPINN_W_STRIDE (wcfg.num_rows + wcfg.bias_en,
+                                     wcfg.num_cols);
+
+  // send all net block dot-products for accumulation,
+  for (uint j = 0; j < wcfg.num_cols; j++)
+  {
+    net_t const net_part = wf_spec_rdy ? w_spec_nets[j]
+                             : wf_net_part (wf_procs, j, stride);
 
-    // incorporate net index to the packet key and send
-    while (!spin1_send_mc_packet ((fwdKey | j), (uint) net_part, WITH_PAYLOAD));
+    // incorporate net (group) index to the packet key and send
+    tx_send ((fwdKey | (wcfg.col_base + j)), (uint) net_part,
+             WITH_PAYLOAD);
 
 #ifdef DEBUG
     pkt_sent++;
@@ -62,8 +289,14 @@ void wf_process (uint unused0, uint unused1)
 #endif
   }
 
+  // speculative partial nets (if any) have been used,
+  wf_spec_rdy = FALSE;
+
+  // and prepare partial nets to stream the outputs of the next tick
+  wf_init_nets (wf_procs);
+
   // access thread semaphore with interrupts disabled
-  uint cpsr = spin1_int_disable ();
+  cpsr = spin1_int_disable ();
 
 #if defined(DEBUG) && defined(DEBUG_THRDS)
   if (!(wf_thrds_pend & SPINN_THRD_PROC))
@@ -87,6 +320,12 @@ void wf_process (uint unused0, uint unused1)
     // if not done report processing thread done,
     wf_thrds_pend &= ~SPINN_THRD_PROC;
 
+    // compute the next partial nets while waiting for the stop decision,
+    if (wf_thrds_pend == SPINN_THRD_STOP)
+    {
+      spin1_schedule_callback (wf_speculate, 0, 0, SPINN_WF_SPEC_P);
+    }
+
     // and restore interrupts after semaphore access
     spin1_mode_restore (cpsr);
   }
@@ -95,67 +334,128 @@ void wf_process (uint unused0, uint unused1)
 
 
 // ------------------------------------------------------------------------
-// process BACKPROP data packet
-// compute partial products (weight * delta)
+// FORWARD phase: all the unit outputs of the tick have arrived and only
+// the tick stop decision is pending. The next tick is almost always
+// needed, so compute its partial nets now: they are sent as soon as the
+// decision arrives or discarded if it ends the example
 // ------------------------------------------------------------------------
-void wb_process (uint key, uint payload)
+void wf_speculate (uint unused0, uint unused1)
 {
-#ifdef DEBUG
-  recv_bkp++;
-  if (phase == SPINN_FORWARD)
-    wrng_bph++;
+  (void) unused0;
+  (void) unused1;
+
+#ifdef TRACE
+  io_printf (IO_BUF, "wf_speculate\n");
+#endif
+
+  // access thread semaphore with interrupts disabled,
+  uint cpsr = spin1_int_disable ();
+
+  // check that the tick stop decision is still pending,
+  uint const pending = (wf_thrds_pend == SPINN_THRD_STOP);
+
+  // and restore interrupts after semaphore access
+  spin1_mode_restore (cpsr);
 
-  uint blk = (key & SPINN_BLOCK_MASK) >> SPINN_BLOCK_SHIFT;
-  if (blk != wcfg.col_blk)
+  if (!pending)
   {
-    pkt_bwbk++;
     return;
   }
-#endif
 
-  // get delta index: mask out phase and block data,
-  uint inx = key & SPINN_BLKDLT_MASK;
+  uint const stride = SPINN_W_STRIDE (wcfg.num_rows + wcfg.bias_en,
+                                     wcfg.num_cols);
+
+  // the unit outputs received in this tick are processed in the next one
+  for (uint j = 0; j < wcfg.num_cols; j++)
+  {
+    w_spec_nets[j] = wf_net_part (1 - wf_procs, j, stride);
+  }
+
+  wf_spec_rdy = TRUE;
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// initialise a set of running partial nets to the bias weights
+// (bias unit output is always one), ready to stream unit outputs
+// ------------------------------------------------------------------------
+void wf_init_nets (uint nets)
+{
+  uint const stride = SPINN_W_STRIDE (wcfg.num_rows + wcfg.bias_en,
+                                     wcfg.num_cols);
+
+  for (uint j = 0; j < wcfg.num_cols; j++)
+  {
+    w_nets[nets][j] = w_bias_net (j, stride);
+  }
+
+  w_nets_rdy[nets] = TRUE;
+}
+// ------------------------------------------------------------------------
 
-  // packet carries a delta as payload
-  delta_t delta = (delta_t) payload;
 
+// ------------------------------------------------------------------------
+// compute partial products (weight * delta) for the delta of column inx
+// ------------------------------------------------------------------------
+static void wb_delta (uint inx, delta_t delta)
+{
   // update scoreboard,
   wb_arrived++;
 
   // partial value used to compute Doug's Momentum
   long_lds_t link_delta_sum = 0;
 
+  uint const stride = SPINN_W_BP_STRIDE (wcfg.num_rows + wcfg.bias_en,
+                                        wcfg.num_cols);
+
+  // loop invariants: link delta and error stores may alias globals
+  uint const num_rows = wcfg.num_rows;
+  fpreal const delta_dt = w_delta_dt;
+  uchar const net_cont = (ncfg.net_type == SPINN_NET_CONT);
+  uchar const all_arrived = (wb_arrived == wcfg.num_cols);
+  uchar const wt_short = (wcfg.weight_format == SPINN_WEIGHT_16);
+  uint ovf = 0;
+
+  // if using Doug's Momentum and reached the end of an epoch
+  // accumulate partial link delta sum (to send to s core)
+  uchar const lds_sum = (xcfg.update_function == SPINN_DOUGSMOMENTUM_UPDATE
+                          && example_cnt == (xcfg.num_examples - 1)
+                          && tick == SPINN_WB_END_TICK);
+
   // compute link derivatives and partial error dot products,
-  for (uint i = 0; i < wcfg.num_rows; i++)
+  for (uint i = 0; i < num_rows; i++)
   {
+    uint const k = SPINN_W_BP_INX (i, inx, stride);
+
     // compute link derivatives,
-    w_link_deltas[i][inx] += ((long_delta_t) w_outputs[0][i]
-                               * (long_delta_t) delta)
-                               >> (SPINN_ACTIV_SHIFT + SPINN_DELTA_SHIFT
-                               - SPINN_LONG_DELTA_SHIFT);
-
-    // if using Doug's Momentum and reached the end of an epoch
-    // accumulate partial link delta sum (to send to s core),
-    if (xcfg.update_function == SPINN_DOUGSMOMENTUM_UPDATE
-          && example_cnt == (xcfg.num_examples - 1)
-          && tick == SPINN_WB_END_TICK)
+    w_link_deltas[k] = w_sat_delta ((long_delta_t) w_link_deltas[k]
+                          + (((long_delta_t) w_outputs[0][i]
+                          * (long_delta_t) delta)
+                          >> (SPINN_ACTIV_SHIFT + SPINN_DELTA_SHIFT
+                          - SPINN_W_DELTA_SHIFT)), &ovf);
+
+    // accumulate partial link delta sum, if required,
+    if (lds_sum)
     {
       // only use link derivatives for links whose weights are non-zero
       // as zero weights indicate no connection
-      if (w_weights[i][inx] != 0)
+      if (w_get_weight_bp (k, wt_short) != 0)
       {
         long_lds_t link_delta_tmp;
 
         // scale the link derivatives
-        if (ncfg.net_type == SPINN_NET_CONT)
+        if (net_cont)
         {
-          link_delta_tmp = (w_link_deltas[i][inx] * (long_delta_t) w_delta_dt)
-                               >> (SPINN_LONG_DELTA_SHIFT + SPINN_FPREAL_SHIFT
+          link_delta_tmp = ((long_delta_t) w_link_deltas[k]
+                               * (long_delta_t) delta_dt)
+                               >> (SPINN_W_DELTA_SHIFT + SPINN_FPREAL_SHIFT
                                    - SPINN_LONG_LDS_SHIFT);
         }
         else
         {
-          link_delta_tmp = w_link_deltas[i][inx];
+          link_delta_tmp = (long_delta_t) w_link_deltas[k]
+                             << (SPINN_LONG_DELTA_SHIFT - SPINN_W_DELTA_SHIFT);
         }
 
         // square the link derivatives
@@ -166,19 +466,29 @@ void wb_process (uint key, uint payload)
 
     // partially compute error dot products,
     //NOTE: may need to make w_errors a long_error_t type and saturate!
-    w_errors[i] += (error_t) (((long_error_t) w_weights[i][inx]
-                     * (long_error_t) delta)
-                     >> (SPINN_WEIGHT_SHIFT + SPINN_DELTA_SHIFT
-                     - SPINN_ERROR_SHIFT)
-                   );
+    if (wt_short)
+    {
+      // 16-bit weights need only 32 x 16-bit products
+      w_errors[i] += (error_t) (SPINN_MULWB (delta, w_sweights_bp[k])
+                       >> (SPINN_SHORT_WEIGHT_SHIFT + SPINN_DELTA_SHIFT
+                       - SPINN_MULWB_SHIFT - SPINN_ERROR_SHIFT)
+                     );
+    }
+    else
+    {
+      w_errors[i] += (error_t) (((long_error_t) w_weights_bp[k]
+                       * (long_error_t) delta)
+                       >> (SPINN_WEIGHT_SHIFT + SPINN_DELTA_SHIFT
+                       - SPINN_ERROR_SHIFT)
+                     );
+    }
 
     // check if done with all deltas
-    if (wb_arrived == wcfg.num_cols)
+    if (all_arrived)
     {
       // send computed error dot product,
-      while (!spin1_send_mc_packet ((bkpKey | i),
-              (uint) w_errors[i], WITH_PAYLOAD)
-            );
+      tx_send ((bkpKey | (wcfg.row_base + i)), (uint) w_errors[i],
+               WITH_PAYLOAD);
 
 #ifdef DEBUG
       pkt_sent++;
@@ -190,12 +500,49 @@ void wb_process (uint key, uint payload)
     }
   }
 
+  // index of the bias weight (used only if bias is enabled)
+  uint const kb = SPINN_W_BP_INX (num_rows, inx, stride);
+
+  // compute the bias link derivative: the bias unit output is one,
+  // except on tick 0 (where the link derivative is zero)
+  if (wcfg.bias_en && tick != SPINN_WB_END_TICK)
+  {
+    w_link_deltas[kb] = w_sat_delta ((long_delta_t) w_link_deltas[kb]
+                           + ((long_delta_t) delta
+                           << (SPINN_W_DELTA_SHIFT - SPINN_DELTA_SHIFT)), &ovf);
+  }
+
+  // report optimiser state overflows (if any)
+  w_add_ovf (ovf);
+
   // if using Doug's Momentum and reached the end of an epoch,
   // forward the accumulated partial link delta sums to the s core
-  if (xcfg.update_function == SPINN_DOUGSMOMENTUM_UPDATE
-          && example_cnt == (xcfg.num_examples - 1)
-          && tick == SPINN_WB_END_TICK)
+  if (lds_sum)
   {
+    // add the bias link derivative (if connected),
+    if (wcfg.bias_en && w_get_weight_bp (kb, wt_short) != 0)
+    {
+      long_lds_t link_delta_tmp;
+
+      // scale the link derivative
+      if (net_cont)
+      {
+        link_delta_tmp = ((long_delta_t) w_link_deltas[kb]
+                           * (long_delta_t) delta_dt)
+                           >> (SPINN_W_DELTA_SHIFT + SPINN_FPREAL_SHIFT
+                               - SPINN_LONG_LDS_SHIFT);
+      }
+      else
+      {
+        link_delta_tmp = (long_delta_t) w_link_deltas[kb]
+                           << (SPINN_LONG_DELTA_SHIFT - SPINN_W_DELTA_SHIFT);
+      }
+
+      // square the link derivative
+      link_delta_tmp = ((link_delta_tmp * link_delta_tmp) >> SPINN_LONG_LDS_SHIFT);
+      link_delta_sum = link_delta_sum + link_delta_tmp;
+    }
+
     // cast link_delta_sum to send as payload,
     //NOTE: link deltas are unsigned!
     lds_t lds_to_send;
@@ -208,7 +555,7 @@ void wb_process (uint key, uint payload)
       lds_to_send = (lds_t) link_delta_sum;
 
     // and send partial link delta sum
-    while (!spin1_send_mc_packet (ldsaKey, (uint) lds_to_send, WITH_PAYLOAD));
+    tx_send (ldsaKey, (uint) lds_to_send, WITH_PAYLOAD);
 
 #ifdef DEBUG
     pkt_sent++;
@@ -264,6 +611,90 @@ void wb_process (uint key, uint payload)
 // ------------------------------------------------------------------------+
 
 
+// ------------------------------------------------------------------------
+// process BACKPROP data packet
+// the packet carries a delta as payload or, if packed, the deltas
+// of a pair of units (the second one may be absent)
+// ------------------------------------------------------------------------
+void wb_process (uint key, uint payload)
+{
+#ifdef DEBUG
+  recv_bkp++;
+  if (phase == SPINN_FORWARD)
+    wrng_bph++;
+#endif
+
+  // get delta index: mask out phase and core data,
+  // and make it relative to the first column of the block
+  uint inx = (key & SPINN_DELTA_MASK) - wcfg.col_base;
+
+#ifdef DEBUG
+  if (inx >= wcfg.num_cols)
+  {
+    pkt_bwbk++;
+    return;
+  }
+#endif
+
+  if (!ncfg.packed)
+  {
+    wb_delta (inx, (delta_t) payload);
+  }
+  else
+  {
+    //NOTE: the first delta cannot complete the tick if there is a second
+    wb_delta (inx, (delta_t) SPINN_PAIR_LO (payload)
+                     << (SPINN_DELTA_SHIFT - SPINN_PACKED_DELTA_SHIFT));
+
+    if ((inx + 1) < wcfg.num_cols)
+    {
+      wb_delta (inx + 1, (delta_t) SPINN_PAIR_HI (payload)
+                           << (SPINN_DELTA_SHIFT - SPINN_PACKED_DELTA_SHIFT));
+    }
+  }
+}
+// ------------------------------------------------------------------------
+
+
+// ------------------------------------------------------------------------
+// copy the updated BACKPROP weights into the FORWARD weights
+// (only needed if both layouts are kept)
+// ------------------------------------------------------------------------
+void w_refresh_weights (void)
+{
+#ifdef SPINN_W_DUAL
+  uint const rows = wcfg.num_rows + wcfg.bias_en;
+  uint const cols = wcfg.num_cols;
+  uint const stride = SPINN_W_STRIDE (rows, cols);
+  uint const bp_stride = SPINN_W_BP_STRIDE (rows, cols);
+
+  if (wcfg.weight_format == SPINN_WEIGHT_16)
+  {
+    for (uint j = 0; j < cols; j++)
+    {
+      for (uint i = 0; i < rows; i++)
+      {
+        w_sweights[SPINN_W_INX (i, j, stride)] =
+          w_sweights_bp[SPINN_W_BP_INX (i, j, bp_stride)];
+      }
+    }
+  }
+  else
+  {
+    for (uint j = 0; j < cols; j++)
+    {
+      for (uint i = 0; i < rows; i++)
+      {
+        w_weights[SPINN_W_INX (i, j, stride)] =
+          w_weights_bp[SPINN_W_BP_INX (i, j, bp_stride)];
+      }
+    }
+  }
+#endif
+}
+// ------------------------------------------------------------------------
+
+
 // ------------------------------------------------------------------------
 // perform a weight update using steepest descent
 // a weight of 0 means that there is no connection between the two units.
@@ -280,86 +711,75 @@ void steepest_update_weights (void)
   wght_ups++;
 #endif
 
-  // update weights
-  for (uint j = 0; j < wcfg.num_cols; j++)
+  // update weights (and bias weights, if any) in the BACKPROP copy,
+  // element-wise, so the arenas are swept in storage order
+  uint const size = (wcfg.num_rows + wcfg.bias_en) * wcfg.num_cols;
+
+  // loop invariants: weight and state stores may alias globals
+  fpreal const delta_dt = w_delta_dt;
+  uchar const net_cont = (ncfg.net_type == SPINN_NET_CONT);
+  uchar const wt_short = (wcfg.weight_format == SPINN_WEIGHT_16);
+  uint ovf = 0;
+
+  for (uint k = 0; k < size; k++)
   {
-    for (uint i = 0; i < wcfg.num_rows; i++)
+    weight_t const weight = w_get_weight_bp (k, wt_short);
+
+    // do not update weights that are 0 -- indicates no connection!
+    if (weight != 0)
     {
-      // do not update weights that are 0 -- indicates no connection!
-      if (w_weights[i][j] != 0)
+      // scale the link derivatives
+      if (net_cont)
       {
-        // scale the link derivatives
-        if (ncfg.net_type == SPINN_NET_CONT)
-        {
-          w_link_deltas[i][j] = (w_link_deltas[i][j]
-                                 * (long_delta_t) w_delta_dt)
-                                 >> SPINN_FPREAL_SHIFT;
-        }
+        w_link_deltas[k] = w_sat_delta (((long_delta_t) w_link_deltas[k]
+                            * (long_delta_t) delta_dt)
+                            >> SPINN_FPREAL_SHIFT, &ovf);
+      }
 
-        // compute weight change,
-        long_wchange_t change_tmp = ((long_wchange_t) -wcfg.learningRate *
-                             (long_wchange_t) w_link_deltas[i][j]);
+      // compute weight change,
+      long_wchange_t change_tmp = ((long_wchange_t) -wcfg.learningRate *
+                           (long_wchange_t) w_link_deltas[k]);
 
-        // round off,
-        change_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                        + SPINN_LONG_DELTA_SHIFT
-                                        - SPINN_WEIGHT_SHIFT - 1));
+      // round off,
+      change_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                      + SPINN_W_DELTA_SHIFT
+                                      - SPINN_WEIGHT_SHIFT - 1));
 
-        // and adjust decimal point position
-        w_wchanges[i][j] = change_tmp
-                             >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_LONG_DELTA_SHIFT
-                             - SPINN_WEIGHT_SHIFT);
+      // and adjust decimal point position
+      w_wchanges[k] = w_sat_wchange (change_tmp
+                           >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_W_DELTA_SHIFT
+                           - SPINN_WEIGHT_SHIFT), &ovf);
 
-        if (wcfg.weightDecay > 0)
-        {
-          //apply weight decay
-          long_wchange_t weightDecay_tmp = wcfg.weightDecay * w_weights[i][j];
+      if (wcfg.weightDecay > 0)
+      {
+        //apply weight decay
+        long_wchange_t weightDecay_tmp = wcfg.weightDecay * weight;
 
-          // round off
-          weightDecay_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                               + SPINN_WEIGHT_SHIFT
-                                               - SPINN_WEIGHT_SHIFT - 1));
+        // round off
+        weightDecay_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                             + SPINN_WEIGHT_SHIFT
+                                             - SPINN_WEIGHT_SHIFT - 1));
 
-          // and adjust decimal point position
-          weightDecay_tmp = weightDecay_tmp
-                             >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
-                             - SPINN_WEIGHT_SHIFT);
+        // and adjust decimal point position
+        weightDecay_tmp = weightDecay_tmp
+                           >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
+                           - SPINN_WEIGHT_SHIFT);
 
-          w_wchanges[i][j] = w_wchanges[i][j] - weightDecay_tmp;
-        }
+        w_wchanges[k] = w_sat_wchange ((long_wchange_t) w_wchanges[k]
+                                         - weightDecay_tmp, &ovf);
+      }
 
-        // compute new weight
-        long_weight_t temp = (long_weight_t) w_weights[i][j]
-                              + (long_weight_t) w_wchanges[i][j];
+      // compute new weight
+      long_weight_t temp = (long_weight_t) weight
+                            + (long_weight_t) w_wchanges[k];
 
-        // saturate new weight,
-        if (temp >= (long_weight_t) SPINN_WEIGHT_MAX)
-        {
-          w_weights[i][j] = SPINN_WEIGHT_MAX;
-        }
-        else if (temp <= (long_weight_t) SPINN_WEIGHT_MIN)
-        {
-          w_weights[i][j] = SPINN_WEIGHT_MIN;
-        }
-        // and avoid (new weight == 0) -- indicates no connection!
-        else if (temp == 0)
-        {
-          if (w_weights[i][j] > 0)
-          {
-            w_weights[i][j] = SPINN_WEIGHT_POS_EPSILON;
-          }
-          else
-          {
-            w_weights[i][j] = SPINN_WEIGHT_NEG_EPSILON;
-          }
-        }
-        else
-        {
-          w_weights[i][j] = (weight_t) temp;
-        }
-      }
+      // and store it (saturated and non-zero)
+      w_put_weight_bp (k, weight, temp, wt_short);
     }
   }
+
+  // report optimiser state overflows (if any)
+  w_add_ovf (ovf);
 }
 // ------------------------------------------------------------------------
 
@@ -380,97 +800,86 @@ void momentum_update_weights (void)
   wght_ups++;
 #endif
 
-  // update weights
-  for (uint j = 0; j < wcfg.num_cols; j++)
+  // update weights (and bias weights, if any) in the BACKPROP copy,
+  // element-wise, so the arenas are swept in storage order
+  uint const size = (wcfg.num_rows + wcfg.bias_en) * wcfg.num_cols;
+
+  // loop invariants: weight and state stores may alias globals
+  fpreal const delta_dt = w_delta_dt;
+  uchar const net_cont = (ncfg.net_type == SPINN_NET_CONT);
+  uchar const wt_short = (wcfg.weight_format == SPINN_WEIGHT_16);
+  uint ovf = 0;
+
+  for (uint k = 0; k < size; k++)
   {
-    for (uint i = 0; i < wcfg.num_rows; i++)
+    weight_t const weight = w_get_weight_bp (k, wt_short);
+
+    // do not update weights that are 0 -- indicates no connection!
+    if (weight != 0)
     {
-      // do not update weights that are 0 -- indicates no connection!
-      if (w_weights[i][j] != 0)
+      // scale the link derivatives
+      if (net_cont)
       {
-        // scale the link derivatives
-        if (ncfg.net_type == SPINN_NET_CONT)
-        {
-          w_link_deltas[i][j] = (w_link_deltas[i][j]
-                                 * (long_delta_t) w_delta_dt)
-                                 >> SPINN_FPREAL_SHIFT;
-        }
+        w_link_deltas[k] = w_sat_delta (((long_delta_t) w_link_deltas[k]
+                            * (long_delta_t) delta_dt)
+                            >> SPINN_FPREAL_SHIFT, &ovf);
+      }
 
-        // compute weight change,
-        long_wchange_t change_tmp = ((long_wchange_t) -wcfg.learningRate *
-                             (long_wchange_t) w_link_deltas[i][j]);
+      // compute weight change,
+      long_wchange_t change_tmp = ((long_wchange_t) -wcfg.learningRate *
+                           (long_wchange_t) w_link_deltas[k]);
 
 
-        // round off,
-        change_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                        + SPINN_LONG_DELTA_SHIFT
-                                        - SPINN_WEIGHT_SHIFT - 1));
+      // round off,
+      change_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                      + SPINN_W_DELTA_SHIFT
+                                      - SPINN_WEIGHT_SHIFT - 1));
 
-        // compute momentum factor
-        long_wchange_t momentum_tmp = ((long_wchange_t) wcfg.momentum * w_wchanges[i][j]);
+      // compute momentum factor
+      long_wchange_t momentum_tmp = ((long_wchange_t) wcfg.momentum * w_wchanges[k]);
 
-        // round off
-        momentum_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                          + SPINN_WEIGHT_SHIFT
-                                          - SPINN_WEIGHT_SHIFT - 1));
-
-        // compute sum and adjust decimal point position
-        w_wchanges[i][j] =
-                (change_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_LONG_DELTA_SHIFT
-                              - SPINN_WEIGHT_SHIFT))
-              + (momentum_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
-                              - SPINN_WEIGHT_SHIFT));
-
-        if (wcfg.weightDecay > 0)
-        {
-          //apply weight decay
-          long_wchange_t weightDecay_tmp = wcfg.weightDecay * w_weights[i][j];
+      // round off
+      momentum_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                        + SPINN_WEIGHT_SHIFT
+                                        - SPINN_WEIGHT_SHIFT - 1));
 
-          // round off
-          weightDecay_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                               + SPINN_WEIGHT_SHIFT
-                                               - SPINN_WEIGHT_SHIFT - 1));
+      // compute sum and adjust decimal point position
+      w_wchanges[k] = w_sat_wchange (
+              (change_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_W_DELTA_SHIFT
+                            - SPINN_WEIGHT_SHIFT))
+            + (momentum_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
+                            - SPINN_WEIGHT_SHIFT)), &ovf);
 
-          // and adjust decimal point position
-          weightDecay_tmp = weightDecay_tmp
-                             >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
-                             - SPINN_WEIGHT_SHIFT);
+      if (wcfg.weightDecay > 0)
+      {
+        //apply weight decay
+        long_wchange_t weightDecay_tmp = wcfg.weightDecay * weight;
 
-          w_wchanges[i][j] = w_wchanges[i][j] - weightDecay_tmp;
-        }
+        // round off
+        weightDecay_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                             + SPINN_WEIGHT_SHIFT
+                                             - SPINN_WEIGHT_SHIFT - 1));
 
-        // compute new weight
-        long_weight_t temp = (long_weight_t) w_weights[i][j]
-                              + (long_weight_t) w_wchanges[i][j];
+        // and adjust decimal point position
+        weightDecay_tmp = weightDecay_tmp
+                           >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
+                           - SPINN_WEIGHT_SHIFT);
 
-        // saturate new weight,
-        if (temp >= (long_weight_t) SPINN_WEIGHT_MAX)
-        {
-          w_weights[i][j] = SPINN_WEIGHT_MAX;
-        }
-        else if (temp <= (long_weight_t) SPINN_WEIGHT_MIN)
-        {
-          w_weights[i][j] = SPINN_WEIGHT_MIN;
-        }
-        // and avoid (new weight == 0) -- indicates no connection!
-        else if (temp == 0)
-        {
-          if (w_weights[i][j] > 0)
-          {
-            w_weights[i][j] = SPINN_WEIGHT_POS_EPSILON;
-          }
-          else
-          {
-            w_weights[i][j] = SPINN_WEIGHT_NEG_EPSILON;
-          }
-        }
-        else
-        {
-          w_weights[i][j] = (weight_t) temp;
-        }
+        w_wchanges[k] = w_sat_wchange ((long_wchange_t) w_wchanges[k]
+                                         - weightDecay_tmp, &ovf);
       }
+
+      // compute new weight
+      long_weight_t temp = (long_weight_t) weight
+                            + (long_weight_t) w_wchanges[k];
+
+      // and store it (saturated and non-zero)
+      w_put_weight_bp (k, weight, temp, wt_short);
     }
   }
+
+  // report optimiser state overflows (if any)
+  w_add_ovf (ovf);
 }
 // ------------------------------------------------------------------------
 
@@ -508,97 +917,86 @@ void dougsmomentum_update_weights (void)
   // multiply learning scale by learning rate
   scale = (scale * wcfg.learningRate) >> SPINN_SHORT_FPREAL_SHIFT;
 
-  // update weights
-  for (uint j = 0; j < wcfg.num_cols; j++)
+  // update weights (and bias weights, if any) in the BACKPROP copy,
+  // element-wise, so the arenas are swept in storage order
+  uint const size = (wcfg.num_rows + wcfg.bias_en) * wcfg.num_cols;
+
+  // loop invariants: weight and state stores may alias globals
+  fpreal const delta_dt = w_delta_dt;
+  uchar const net_cont = (ncfg.net_type == SPINN_NET_CONT);
+  uchar const wt_short = (wcfg.weight_format == SPINN_WEIGHT_16);
+  uint ovf = 0;
+
+  for (uint k = 0; k < size; k++)
   {
-    for (uint i = 0; i < wcfg.num_rows; i++)
+    weight_t const weight = w_get_weight_bp (k, wt_short);
+
+    // do not update weights that are 0 -- indicates no connection!
+    if (weight != 0)
     {
-      // do not update weights that are 0 -- indicates no connection!
-      if (w_weights[i][j] != 0)
+      // scale the link derivatives
+      if (net_cont)
       {
-        // scale the link derivatives
-        if (ncfg.net_type == SPINN_NET_CONT)
-        {
-          w_link_deltas[i][j] = (w_link_deltas[i][j]
-                                 * (long_delta_t) w_delta_dt)
-                                 >> SPINN_FPREAL_SHIFT;
-        }
+        w_link_deltas[k] = w_sat_delta (((long_delta_t) w_link_deltas[k]
+                            * (long_delta_t) delta_dt)
+                            >> SPINN_FPREAL_SHIFT, &ovf);
+      }
 
-        // compute weight change,
-        long_wchange_t change_tmp = ((long_wchange_t) -scale *
-                             (long_wchange_t) w_link_deltas[i][j]);
+      // compute weight change,
+      long_wchange_t change_tmp = ((long_wchange_t) -scale *
+                           (long_wchange_t) w_link_deltas[k]);
 
 
-        // round off,
-        change_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                        + SPINN_LONG_DELTA_SHIFT
-                                        - SPINN_WEIGHT_SHIFT - 1));
+      // round off,
+      change_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                      + SPINN_W_DELTA_SHIFT
+                                      - SPINN_WEIGHT_SHIFT - 1));
 
-        // compute momentum factor
-        long_wchange_t momentum_tmp = ((long_wchange_t) wcfg.momentum * w_wchanges[i][j]);
+      // compute momentum factor
+      long_wchange_t momentum_tmp = ((long_wchange_t) wcfg.momentum * w_wchanges[k]);
 
-        // round off
-        momentum_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                          + SPINN_WEIGHT_SHIFT
-                                          - SPINN_WEIGHT_SHIFT - 1));
-
-        // compute sum and adjust decimal point position
-        w_wchanges[i][j] =
-                (change_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_LONG_DELTA_SHIFT
-                              - SPINN_WEIGHT_SHIFT))
-              + (momentum_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
-                              - SPINN_WEIGHT_SHIFT));
-
-        if (wcfg.weightDecay > 0)
-        {
-          //apply weight decay
-          long_wchange_t weightDecay_tmp = wcfg.weightDecay * w_weights[i][j];
+      // round off
+      momentum_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                        + SPINN_WEIGHT_SHIFT
+                                        - SPINN_WEIGHT_SHIFT - 1));
 
-          // round off
-          weightDecay_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
-                                               + SPINN_WEIGHT_SHIFT
-                                               - SPINN_WEIGHT_SHIFT - 1));
+      // compute sum and adjust decimal point position
+      w_wchanges[k] = w_sat_wchange (
+              (change_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_W_DELTA_SHIFT
+                            - SPINN_WEIGHT_SHIFT))
+            + (momentum_tmp >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
+                            - SPINN_WEIGHT_SHIFT)), &ovf);
 
-          // and adjust decimal point position
-          weightDecay_tmp = weightDecay_tmp
-                             >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
-                             - SPINN_WEIGHT_SHIFT);
+      if (wcfg.weightDecay > 0)
+      {
+        //apply weight decay
+        long_wchange_t weightDecay_tmp = wcfg.weightDecay * weight;
 
-          w_wchanges[i][j] = w_wchanges[i][j] - weightDecay_tmp;
-        }
+        // round off
+        weightDecay_tmp += (long_wchange_t) (1 << (SPINN_SHORT_FPREAL_SHIFT
+                                             + SPINN_WEIGHT_SHIFT
+                                             - SPINN_WEIGHT_SHIFT - 1));
 
-        // compute new weight
-        long_weight_t temp = (long_weight_t) w_weights[i][j]
-                              + (long_weight_t) w_wchanges[i][j];
+        // and adjust decimal point position
+        weightDecay_tmp = weightDecay_tmp
+                           >> (SPINN_SHORT_FPREAL_SHIFT + SPINN_WEIGHT_SHIFT
+                           - SPINN_WEIGHT_SHIFT);
 
-        // saturate new weight,
-        if (temp >= (long_weight_t) SPINN_WEIGHT_MAX)
-        {
-          w_weights[i][j] = SPINN_WEIGHT_MAX;
-        }
-        else if (temp <= (long_weight_t) SPINN_WEIGHT_MIN)
-        {
-          w_weights[i][j] = SPINN_WEIGHT_MIN;
-        }
-        // and avoid (new weight == 0) -- indicates no connection!
-        else if (temp == 0)
-        {
-          if (w_weights[i][j] > 0)
-          {
-            w_weights[i][j] = SPINN_WEIGHT_POS_EPSILON;
-          }
-          else
-          {
-            w_weights[i][j] = SPINN_WEIGHT_NEG_EPSILON;
-          }
-        }
-        else
-        {
-          w_weights[i][j] = (weight_t) temp;
-        }
+        w_wchanges[k] = w_sat_wchange ((long_wchange_t) w_wchanges[k]
+                                         - weightDecay_tmp, &ovf);
       }
+
+      // compute new weight
+      long_weight_t temp = (long_weight_t) weight
+                            + (long_weight_t) w_wchanges[k];
+
+      // and store it (saturated and non-zero)
+      w_put_weight_bp (k, weight, temp, wt_short);
     }
   }
+
+  // report optimiser state overflows (if any)
+  w_add_ovf (ovf);
 }
 // ------------------------------------------------------------------------
 
@@ -640,8 +1038,15 @@ void wf_advance_tick (uint unused0, uint unused1)
     // if not increment tick,
     tick++;
 
-    // and trigger computation
-    spin1_schedule_callback (wf_process, 0, 0, SPINN_WF_PROCESS_P);
+    // and trigger computation -- send speculative partial nets now
+    if (wf_spec_rdy)
+    {
+      wf_process (0, 0);
+    }
+    else
+    {
+      spin1_schedule_callback (wf_process, 0, 0, SPINN_WF_PROCESS_P);
+    }
   }
 }
 // ------------------------------------------------------------------------
@@ -706,6 +1111,15 @@ void wf_advance_event (void)
     // initialise thread semaphore,
     wf_thrds_pend = SPINN_WF_THRDS;
 
+    // stop streaming outputs - weights may change before next example,
+    wf_stream = FALSE;
+
+    // discard speculative partial nets - next example starts afresh,
+#ifdef DEBUG
+    spc_drop += wf_spec_rdy;
+#endif
+    wf_spec_rdy = FALSE;
+
     // restore interrupts after flag access,
     spin1_mode_restore (cpsr);
 
@@ -729,8 +1143,15 @@ void wf_advance_event (void)
     // if not increment tick,
     tick++;
 
-    // and trigger computation
-    spin1_schedule_callback (wf_process, 0, 0, SPINN_WF_PROCESS_P);
+    // and trigger computation -- send speculative partial nets now
+    if (wf_spec_rdy)
+    {
+      wf_process (0, 0);
+    }
+    else
+    {
+      spin1_schedule_callback (wf_process, 0, 0, SPINN_WF_PROCESS_P);
+    }
   }
 }
 // ------------------------------------------------------------------------
@@ -765,13 +1186,13 @@ void w_advance_example (void)
     if (xcfg.training)
     {
       wb_update_func ();
+      w_refresh_weights ();
 
-      for (uint i = 0; i < wcfg.num_rows; i++)
+      uint const size = (wcfg.num_rows + wcfg.bias_en) * wcfg.num_cols;
+
+      for (uint k = 0; k < size; k++)
       {
-        for (uint j = 0; j < wcfg.num_cols; j++)
-        {
-          w_link_deltas[i][j] = 0;
-        }
+        w_link_deltas[k] = 0;
       }
     }
   }
@@ -786,11 +1207,12 @@ void w_advance_example (void)
   evt = 0;
   num_events = ex[example_inx].num_events;
 
-  // initialise unit outputs,
+  // initialise unit outputs (not streamed into the partial nets),
   for (uint i = 0; i < wcfg.num_rows; i++)
   {
     w_outputs[wf_procs][i] = wcfg.initOutput;
   }
+  w_nets_rdy[wf_procs] = FALSE;
 
   // access sync and net_stop flags with interrupts disabled,
   uint cpsr = spin1_int_disable ();
@@ -2,6 +2,8 @@
 #define __PROCESS_W_H__
 
 void wf_process (uint unused0, uint unused1);
+void wf_speculate (uint unused0, uint unused1);
+void wf_init_nets (uint nets);
 void wb_process (uint key,     uint payload);
 
 void wf_advance_tick   (uint unused0, uint unused1);
@@ -14,6 +16,7 @@ void w_switch_to_bp    (void);
 void steepest_update_weights      (void);
 void momentum_update_weights      (void);
 void dougsmomentum_update_weights (void);
+void w_refresh_weights            (void);
 void w_weight_deltas              (void);
 
 #endif
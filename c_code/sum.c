@@ -46,6 +46,7 @@ proc_phase_t phase;        // FORWARD or BACKPROP
 uint         max_ticks;    // maximum number of ticks in current event
 uint         min_ticks;    // minimum number of ticks in current event
 uint         tick;         // current tick in phase
+uint         ev_tick;      // current tick in event
 uchar        tick_stop;    // current tick stop decision
 
 uint         to_epoch   = 0;
@@ -59,6 +60,7 @@ uint         to_tick    = 0;
 // ------------------------------------------------------------------------
 mlp_set_t        * es;     // example set data
 mlp_example_t    * ex;     // example data
+mlp_event_t      * ev;     // event data
 uint             * rt;     // multicast routing keys data
 // ------------------------------------------------------------------------
 
@@ -88,7 +90,11 @@ lds_t            s_lds_part;        // partial link delta sum
 // (net computation)
 scoreboard_t   * sf_arrived[2];     // keep count of expected net b-d-p
 scoreboard_t     sf_done;           // current tick net computation done
+scoreboard_t   * sf_batch[2];       // net b-d-ps arrived in current batch
+uint           * sf_batch_units;    // units (and colours) in current batch
+uint             sf_batch_len;      // number of units in current batch
 uint             sf_thrds_pend;     // thread semaphore
+uint             sf_thrds_init;     // thread semaphore initial value
 
 // BACKPROP phase specific
 // (error computation)
@@ -97,6 +103,7 @@ scoreboard_t     sb_done;           // current tick error computation done
 uint             sb_thrds_pend;     // thread semaphore
 scoreboard_t     s_ldsa_arrived;    // keep count of the number of partial link delta sums
 scoreboard_t     s_ldst_arrived;    // keep count of the number of link delta sum totals
+uchar            s_ldsr_arrived;    // link delta sum result arrived?
 // ------------------------------------------------------------------------
 
 
@@ -118,6 +125,7 @@ uint lda_recv;  // partial link_delta packets received
 uint ldt_sent;  // total link_delta packets sent
 uint ldt_recv;  // total link_delta packets received
 uint ldr_sent;  // link_delta packets sent
+uint ldr_recv;  // link_delta packets received
 uint wrng_phs;  // packets received in wrong phase
 uint wrng_pth;  // unexpected processing thread
 uint wrng_cth;  // unexpected comms thread
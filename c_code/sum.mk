@@ -7,7 +7,7 @@ APP = sum
 APP_OUTPUT_DIR = ../binaries/
 
 SOURCE_DIRS = .
-SOURCES = sum.c comms_s.c process_s.c init_s.c
+SOURCES = sum.c comms_s.c process_s.c init_s.c comms_tx.c
 
 LIBRARIES += -lm
 
@@ -152,9 +152,9 @@ pkt_queue_t      t_pkt_queue;       // queue to hold received nets
 uchar            tf_active;         // processing FWD-phase packet queue?
 scoreboard_t     tf_arrived;        // keep count of expected nets
 uint             tf_thrds_pend;     // thread semaphore
-uchar            tf_crit_prev;      // criterion value received
-uchar            tf_init_crit;      // criterion init value
-uchar            tf_crit_rdy;       // criterion can be forwarded
+uint             tf_thrds_init;     // thread semaphore initial value
+uchar            tf_crit_prev;      // criterion values received
+uint             tf_crit_pend;      // criterion values pending (and local)
 uchar            tf_stop_crit;      // stop criterion met?
 uchar            tf_group_crit;     // stop criterion met for all groups?
 uchar            tf_event_crit;     // stop criterion met for all events?
@@ -176,11 +176,17 @@ int              t_max_output_unit; // unit with highest output
 int              t_max_target_unit; // unit with highest target
 activation_t     t_max_output;      // highest output value
 activation_t     t_max_target;      // highest target value
+activation_t     t_max_prev_output; // highest output of previous slices
+activation_t     t_max_prev_target; // highest target of previous slices
+uchar            t_max_prev_same;   // both on the same unit?
+uchar            t_max_evaluated;   // units evaluated in this tick?
+uchar            t_max_prev_evaluated; // and in previous slices?
 
 long_deriv_t   * t_output_deriv;    // derivative of the output value
 delta_t        * t_deltas;
 
-uint           * t_fwdKey;          // t cores have one fwdKey per partition
+uint           * t_fwdKey;          // t cores have one fwdKey per unit
+uchar          * t_pair;            // position of every unit in its pair
 
 // history arrays
 net_t          * t_net_history;
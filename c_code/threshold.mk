@@ -7,7 +7,7 @@ APP = threshold
 APP_OUTPUT_DIR = ../binaries/
 
 SOURCE_DIRS = .
-SOURCES = threshold.c comms_t.c process_t.c init_t.c activation.c
+SOURCES = threshold.c comms_t.c process_t.c init_t.c comms_tx.c activation.c
 
 LIBRARIES += -lm
 
@@ -93,11 +93,26 @@ address_t      xadr;           // stage configuration SDRAM address
 // ------------------------------------------------------------------------
 // weight cores compute net and error block dot-products (b-d-p),
 // and weight updates.
+// weights, weight changes and link deltas are single arenas indexed
+// with SPINN_W_INX. Weights are loaded from SDRAM with one DMA transfer.
+// The BACKPROP phase and the weight updates use w_weights_bp, which is
+// w_weights unless both layouts are kept (SPINN_W_DUAL).
+// If the network stores 16-bit weights (SPINN_WEIGHT_16) w_sweights and
+// w_sweights_bp are used instead and w_weights and w_weights_bp are NULL.
+// Link deltas and weight changes are 32-bit if SPINN_W_COMPACT is defined.
 // ------------------------------------------------------------------------
-weight_t       * * w_weights;         // connection weights block
-long_wchange_t * * w_wchanges;        // accumulated weight changes
+weight_t         * w_weights;         // connection weights block
+weight_t         * w_weights_bp;      // BACKPROP copy of the weights
+short_weight_t   * w_sweights;        // 16-bit connection weights block
+short_weight_t   * w_sweights_bp;     // BACKPROP copy of the 16-bit weights
+w_wchange_t      * w_wchanges;        // accumulated weight changes
 activation_t     * w_outputs[2];      // unit outputs for b-d-p
-long_delta_t   * * w_link_deltas;     // computed link deltas
+w_delta_t        * w_link_deltas;     // computed link deltas
+uchar              w_wts_rdy;         // weights loaded from SDRAM?
+#ifdef SPINN_W_COMPACT
+uint               w_ovf_cnt;         // saturated optimiser state stores
+#endif
+uchar              wf_start_rdy;      // stage waiting for weights?
 error_t          * w_errors;          // computed errors next tick
 pkt_queue_t        w_pkt_queue;       // queue to hold received packets
 fpreal             w_delta_dt;        // scaling factor for link deltas
@@ -109,8 +124,16 @@ scoreboard_t       w_sync_arrived;    // keep count of expected sync packets
 // Two sets of received unit outputs are kept:
 // procs = in use for current b-d-p computation
 // comms = being received for next tick
+// received outputs are streamed into running partial nets, one set
+// per set of unit outputs, so that only the partial nets need to be
+// sent when the tick is processed.
 uint             wf_procs;          // pointer to processing unit outputs
 uint             wf_comms;          // pointer to receiving unit outputs
+long_net_t     * w_nets[2];         // running partial nets (one per column)
+uchar            w_nets_rdy[2];     // partial nets include received outputs?
+uchar            wf_stream;         // stream received outputs into nets?
+net_t          * w_spec_nets;       // next tick partial nets (speculative)
+uchar            wf_spec_rdy;       // speculative partial nets computed?
 scoreboard_t     wf_arrived;        // keep count of received unit outputs
 uint             wf_thrds_pend;     // thread semaphore
 
@@ -150,6 +173,7 @@ uint wght_ups;  // number of weight updates done
 uint wrng_pth;  // unexpected processing thread
 uint wrng_cth;  // unexpected comms thread
 uint wrng_sth;  // unexpected stop thread
+uint spc_drop;  // speculative partial nets discarded
 uint tot_tick;  // total number of ticks executed
 // ------------------------------------------------------------------------
 #endif
@@ -225,6 +249,9 @@ void c_main ()
     stage_done (exit_code, 0);
   }
 
+  // set up DMA callback (weights are loaded by DMA),
+  spin1_callback_on (DMA_TRANSFER_DONE, w_dma_done, SPINN_DMA_P);
+
   // initialise variables,
   var_init (TRUE, TRUE);
 
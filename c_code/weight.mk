@@ -7,7 +7,7 @@ APP = weight
 APP_OUTPUT_DIR = ../binaries/
 
 SOURCE_DIRS = .
-SOURCES = weight.c comms_w.c process_w.c init_w.c activation.c
+SOURCES = weight.c comms_w.c process_w.c init_w.c comms_tx.c activation.c
 
 LIBRARIES += -lm
 
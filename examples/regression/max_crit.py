@@ -0,0 +1,122 @@
+import os
+import sys
+
+from spinn_pdp2.mlp_network import MLPNetwork
+from spinn_pdp2.mlp_types   import MLPNetworkTypes, MLPGroupTypes
+from spinn_pdp2.mlp_types   import MLPInputProcs, MLPStopCriteria
+from spinn_pdp2.mlp_types   import MLPBackends, MLPConstants
+
+#-----------------------------------------------------------
+# max_crit
+#
+# regression run of the "max" stop criterion: trains the
+# rand10x40 network with the output group in a single core
+# and split into slices of 4 units (whose partial maxima
+# are chained along the slices) and checks that the outputs
+# are the same
+#
+# both runs use the host simulator, which can run the
+# two networks in the same process
+#
+#-----------------------------------------------------------
+
+def run (slice_units, output_file):
+    # groups are split when they are built
+    MLPConstants.MAX_SLICE_UNITS = slice_units
+    MLPConstants.MAX_BLK_UNITS = slice_units
+
+    # instantiate the MLP network
+    rand10x40 = MLPNetwork (net_type = MLPNetworkTypes.CONTINUOUS,
+                            intervals = 4,
+                            ticks_per_interval = 5,
+                            backend = MLPBackends.HOST
+                            )
+
+    # instantiate network groups (layers)
+    Input  = rand10x40.group (units = 10,
+                              group_type = [MLPGroupTypes.INPUT],
+                              label = "Input"
+                              )
+    Hidden = rand10x40.group (units = 50,
+                              input_funcs = [MLPInputProcs.IN_INTEGR],
+                              label = "Hidden"
+                              )
+    Output = rand10x40.group (units = 10,
+                              group_type = [MLPGroupTypes.OUTPUT],
+                              label = "Output"
+                              )
+
+    # stop ticks on the highest output unit
+    Output.criterion_function = MLPStopCriteria.STOP_MAX
+
+    # instantiate network links
+    rand10x40.link (Input,  Hidden)
+    rand10x40.link (Hidden, Output)
+
+    # instantiate network example set
+    set1 = rand10x40.example_set (label = "set1")
+
+    # read Lens-style examples file
+    set1.read_Lens_examples_file ("../rand10x40/rand10x40.ex")
+
+    # set example set parameters
+    set1.set (grace_time = 1.0,
+              min_time = 1.0,
+              max_time = 4.0
+              )
+
+    # set network parameters
+    rand10x40.set (num_updates = 10,
+                   train_group_crit = 0.2
+                   )
+
+    # set recording option
+    rand10x40.recording_options (rec_test_results = True,
+                                 rec_outputs = True,
+                                 rec_example_last_tick_only = False
+                                 )
+
+    # read initial weights from Lens-generated file
+    rand10x40.read_Lens_weights_file (
+        "../rand10x40/rand10x40_weights.txt")
+
+    # train the network
+    rand10x40.train ()
+
+    # test the network for 20 examples
+    rand10x40.test (num_examples = 20)
+
+    # generate Lens-style output file
+    rand10x40.write_Lens_output_file (output_file)
+
+    # close the application
+    rand10x40.end ()
+
+
+# discard the outputs of previous runs
+for f in ("max_crit_whole.out", "max_crit_4.out"):
+    if os.path.exists (f):
+        os.remove (f)
+
+_slice_units = MLPConstants.MAX_SLICE_UNITS
+_blk_units = MLPConstants.MAX_BLK_UNITS
+
+run (_slice_units, "max_crit_whole.out")
+run (4, "max_crit_4.out")
+
+MLPConstants.MAX_SLICE_UNITS = _slice_units
+MLPConstants.MAX_BLK_UNITS = _blk_units
+
+# a run that aborts writes no output file
+try:
+    with open ("max_crit_whole.out") as fa, open ("max_crit_4.out") as fb:
+        _same = (fa.read () == fb.read ())
+except FileNotFoundError:
+    print ("max_crit: run aborted")
+    sys.exit (1)
+
+if _same:
+    print ("max_crit: outputs agree")
+else:
+    print ("max_crit: outputs differ")
+    sys.exit (1)
@@ -0,0 +1,109 @@
+import os
+import sys
+
+from spinn_pdp2.mlp_network import MLPNetwork
+from spinn_pdp2.mlp_types   import MLPNetworkTypes, MLPGroupTypes
+from spinn_pdp2.mlp_types   import MLPInputProcs, MLPUpdateFuncs
+from spinn_pdp2.mlp_types   import MLPBackends
+
+#-----------------------------------------------------------
+# sum_tree
+#
+# regression run of sum core reduction trees: trains the
+# rand10x40 network with Doug's Momentum without and with
+# a reduction tree (sum_fan_in = 2) and checks that the
+# outputs are the same
+#
+# both runs use the host simulator, which can run the
+# two networks in the same process
+#
+#-----------------------------------------------------------
+
+def run (sum_fan_in, output_file):
+    # instantiate the MLP network
+    rand10x40 = MLPNetwork (net_type = MLPNetworkTypes.CONTINUOUS,
+                            intervals = 4,
+                            ticks_per_interval = 5,
+                            backend = MLPBackends.HOST,
+                            sum_fan_in = sum_fan_in
+                            )
+
+    # instantiate network groups (layers)
+    Input  = rand10x40.group (units = 10,
+                              group_type = [MLPGroupTypes.INPUT],
+                              label = "Input"
+                              )
+    Hidden = rand10x40.group (units = 50,
+                              input_funcs = [MLPInputProcs.IN_INTEGR],
+                              label = "Hidden"
+                              )
+    Output = rand10x40.group (units = 10,
+                              group_type = [MLPGroupTypes.OUTPUT],
+                              label = "Output"
+                              )
+
+    # instantiate network links
+    rand10x40.link (Input,  Hidden)
+    rand10x40.link (Hidden, Output)
+
+    # instantiate network example set
+    set1 = rand10x40.example_set (label = "set1")
+
+    # read Lens-style examples file
+    set1.read_Lens_examples_file ("../rand10x40/rand10x40.ex")
+
+    # set example set parameters
+    set1.set (grace_time = 1.0,
+              min_time = 1.0,
+              max_time = 4.0
+              )
+
+    # set network parameters
+    rand10x40.set (num_updates = 10,
+                   train_group_crit = 0.2
+                   )
+
+    # set recording option
+    rand10x40.recording_options (rec_test_results = True,
+                                 rec_outputs = True,
+                                 rec_example_last_tick_only = False
+                                 )
+
+    # read initial weights from Lens-generated file
+    rand10x40.read_Lens_weights_file (
+        "../rand10x40/rand10x40_weights.txt")
+
+    # train the network with Doug's Momentum
+    rand10x40.train (update_function = MLPUpdateFuncs.UPD_DOUGSMOMENTUM)
+
+    # test the network for 20 examples
+    rand10x40.test (num_examples = 20)
+
+    # generate Lens-style output file
+    rand10x40.write_Lens_output_file (output_file)
+
+    # close the application
+    rand10x40.end ()
+
+
+# discard the outputs of previous runs
+for f in ("sum_tree_flat.out", "sum_tree_2.out"):
+    if os.path.exists (f):
+        os.remove (f)
+
+run (0, "sum_tree_flat.out")
+run (2, "sum_tree_2.out")
+
+# a run that aborts writes no output file
+try:
+    with open ("sum_tree_flat.out") as fa, open ("sum_tree_2.out") as fb:
+        _same = (fa.read () == fb.read ())
+except FileNotFoundError:
+    print ("sum_tree: run aborted")
+    sys.exit (1)
+
+if _same:
+    print ("sum_tree: outputs agree")
+else:
+    print ("sum_tree: outputs differ")
+    sys.exit (1)
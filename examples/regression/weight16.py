@@ -0,0 +1,124 @@
+import os
+import sys
+
+from spinn_pdp2.mlp_network import MLPNetwork
+from spinn_pdp2.mlp_types   import MLPNetworkTypes, MLPGroupTypes
+from spinn_pdp2.mlp_types   import MLPInputProcs, MLPWeightFormats
+from spinn_pdp2.mlp_types   import MLPBackends
+
+#-----------------------------------------------------------
+# weight16
+#
+# regression run of the 16-bit weight format: tests the
+# rand10x40 network with 32-bit and with 16-bit weights
+# and checks that the outputs agree
+#
+# both runs use the host simulator, which can run the
+# two networks in the same process
+#
+#-----------------------------------------------------------
+
+# largest output difference expected between the formats
+TOLERANCE = 1e-4
+
+
+def run (weight_format, output_file):
+    # instantiate the MLP network
+    rand10x40 = MLPNetwork (net_type = MLPNetworkTypes.CONTINUOUS,
+                            intervals = 4,
+                            ticks_per_interval = 5,
+                            backend = MLPBackends.HOST
+                            )
+
+    # instantiate network groups (layers)
+    Input  = rand10x40.group (units = 10,
+                              group_type = [MLPGroupTypes.INPUT],
+                              label = "Input"
+                              )
+    Hidden = rand10x40.group (units = 50,
+                              input_funcs = [MLPInputProcs.IN_INTEGR],
+                              label = "Hidden"
+                              )
+    Output = rand10x40.group (units = 10,
+                              group_type = [MLPGroupTypes.OUTPUT],
+                              label = "Output"
+                              )
+
+    # instantiate network links
+    rand10x40.link (Input,  Hidden)
+    rand10x40.link (Hidden, Output)
+
+    # instantiate network example set
+    set1 = rand10x40.example_set (label = "set1")
+
+    # read Lens-style examples file
+    set1.read_Lens_examples_file ("../rand10x40/rand10x40.ex")
+
+    # set example set parameters
+    set1.set (grace_time = 1.0,
+              min_time = 1.0,
+              max_time = 4.0
+              )
+
+    # select the weight format (before the first run)
+    rand10x40.set (weight_format = weight_format)
+
+    # set recording option
+    rand10x40.recording_options (rec_test_results = True,
+                                 rec_outputs = True,
+                                 rec_example_last_tick_only = False
+                                 )
+
+    # read initial weights from Lens-generated file
+    rand10x40.read_Lens_weights_file (
+        "../rand10x40/rand10x40_weights.txt")
+
+    # test the network for 20 examples
+    rand10x40.test (num_examples = 20)
+
+    # generate Lens-style output file
+    rand10x40.write_Lens_output_file (output_file)
+
+    # close the application
+    rand10x40.end ()
+
+
+def compare (file_a, file_b):
+    # the files must have the same layout and values within tolerance
+    with open (file_a) as fa, open (file_b) as fb:
+        a = fa.read ().split ()
+        b = fb.read ().split ()
+
+    if len (a) != len (b):
+        return False
+
+    for (x, y) in zip (a, b):
+        if '.' in x or '.' in y:
+            if abs (float (x) - float (y)) > TOLERANCE:
+                return False
+        elif x != y:
+            return False
+
+    return True
+
+
+# discard the outputs of previous runs
+for f in ("weight16_32.out", "weight16_16.out"):
+    if os.path.exists (f):
+        os.remove (f)
+
+run (MLPWeightFormats.WEIGHT_32, "weight16_32.out")
+run (MLPWeightFormats.WEIGHT_16, "weight16_16.out")
+
+# a run that aborts writes no output file
+try:
+    _same = compare ("weight16_32.out", "weight16_16.out")
+except FileNotFoundError:
+    print ("weight16: run aborted")
+    sys.exit (1)
+
+if _same:
+    print ("weight16: outputs agree")
+else:
+    print ("weight16: outputs differ")
+    sys.exit (1)
@@ -33,15 +33,23 @@ class InputVertex(
 
     """ A vertex to implement a PDP2 input core
         that applies unit input functions 
+        to one slice of a group
     """
 
     def __init__(self,
                  network,
-                 group
+                 group,
+                 slc = 0
                  ):
 
+        # slices of split groups are labelled with their index
+        if group.slices > 1:
+            _label = f"i_core{group.id}_{slc}"
+        else:
+            _label = f"i_core{group.id}"
+
         super(InputVertex, self).__init__(
-            label = "i_core{}".format (group.id),
+            label = _label,
             binary_name = "input.aplx",
             constraints = None)
 
@@ -50,6 +58,9 @@ class InputVertex(
         # application-level data
         self._network = network
         self._group   = group
+        self._slice   = slc
+        self._units   = group.slice_units (slc)
+        self._parts   = group.slice_partitions (slc)
         self._set_cfg = network._ex_set.set_config
         self._ex_cfg  = network._ex_set.example_config
         self._ev_cfg  = network._ex_set.event_config
@@ -60,8 +71,9 @@ class InputVertex(
         # forward and backprop link partition names
         self._fwd_link = "fwd_i{}".format (self.group.id)
         self._bkp_link = []
-        for p in range (self._group.partitions):
-            self._bkp_link.append ("bkp_i{}_{}".format (self.group.id, p))
+        for p in range (self._parts):
+            self._bkp_link.append ("bkp_i{}_{}".format (self.group.id,
+                slc * self.group.slice_parts + p))
 
         # reserve key space for every link
         self._n_keys = MLPConstants.KEY_SPACE_SIZE
@@ -92,19 +104,20 @@ class InputVertex(
 
         # list of group inputs (empty if not an INPUT group)
         self._N_INPUTS_BYTES = \
-            len (self._group.inputs) * _data_int.size
+            len (self._group.inputs) // self._group.units * \
+            self._units * _data_int.size
 
         # keys are integers
         # i cores require a different key for every group partition
         self._N_KEYS_BYTES = _data_int.size * \
-            (MLPConstants.NUM_KEYS_REQ + self.group.partitions)
+            (MLPConstants.NUM_KEYS_REQ + self._parts)
 
         # stage configuration structure
         self._N_STAGE_CONFIGURATION_BYTES = len (self._network.stage_config)
 
         # reserve SDRAM space used to store historic data
         self._NET_HISTORY_BYTES = (MLPConstants.LONG_NET_SIZE // 8) * \
-            self.group.units * self._network.global_max_ticks
+            self._units * self._network.global_max_ticks
 
 
         self._sdram_usage = (
@@ -123,6 +136,10 @@ class InputVertex(
     def group (self):
         return self._group
 
+    @property
+    def slice (self):
+        return self._slice
+
     @property
     def fwd_link (self):
         return self._fwd_link
@@ -142,6 +159,7 @@ class InputVertex(
               uchar         input_grp;
               uint          num_units;
               uint          partitions;
+              uint          blk_units;
               uint          num_in_procs;
               uint          procs_list[SPINN_NUM_IN_PROCS];
               uchar         in_integr_en;
@@ -165,11 +183,12 @@ class InputVertex(
         init_output = int (self.group.init_output *\
                            (1 << MLPConstants.ACTIV_SHIFT))
 
-        return struct.pack ("<2B2x5IB3x4i",
+        return struct.pack ("<2B2x6IB3x4i",
                             self.group.output_grp,
                             self.group.input_grp,
-                            self.group.units,
-                            self.group.partitions,
+                            self._units,
+                            self._parts,
+                            self.group.blk_units,
                             self.group.num_in_procs,
                             self.group.in_procs_list[0].value,
                             self.group.in_procs_list[1].value,
@@ -202,6 +221,16 @@ class InputVertex(
         # Generate the system data region for simulation.c requirements
         generate_steps_system_data_region(spec, MLPRegions.SYSTEM.value, self)
 
+        # write the application data regions
+        self.write_data_regions (spec, routing_info)
+
+        spec.end_specification ()
+
+
+    def write_data_regions (self, spec, routing_info):
+        """ writes the application SDRAM regions into spec
+            (used for both SpiNNaker and host runs)
+        """
         # Reserve and write the network configuration region
         spec.reserve_memory_region (MLPRegions.NETWORK.value,
                                     self._N_NETWORK_CONFIGURATION_BYTES)
@@ -262,7 +291,8 @@ class InputVertex(
             spec.switch_write_focus (MLPRegions.INPUTS.value)
 
             # write inputs to spec
-            for _i in self._group.inputs:
+            for _i in self.group.slice_data (self.group.inputs,
+                                             self._slice):
                 # inputs are MLP fixed-point activation_t
                 if (_i is None) or (_i == float ('nan')):
                     _inp = MLPConstants.ACTIV_NaN
@@ -292,8 +322,14 @@ class InputVertex(
         # write link keys: lds (padding)
         spec.write_value (0, data_type = DataType.UINT32)
 
+        # write link keys: tck (padding)
+        spec.write_value (0, data_type = DataType.UINT32)
+
+        # write link keys: ldr (padding)
+        spec.write_value (0, data_type = DataType.UINT32)
+
         # write link keys: bkpi
-        for p in range (self.group.partitions):
+        for p in range (self._parts):
             spec.write_value (routing_info.get_first_key_from_pre_vertex (
                 self, self.bkp_link[p]), data_type = DataType.UINT32)
 
@@ -307,8 +343,6 @@ class InputVertex(
         for c in self._network.stage_config:
             spec.write_value (c, data_type = DataType.UINT8)
 
-        spec.end_specification ()
-
 
     @overrides(AbstractRewritesDataSpecification.regenerate_data_specification)
     def regenerate_data_specification(self, spec, placement):
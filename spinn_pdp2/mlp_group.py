@@ -25,10 +25,26 @@ class MLPGroup():
         self.is_first_out = is_first_out
         self.label        = label
 
-        # number of partitions required for this group
-        self.partitions = (self.units + MLPConstants.MAX_BLK_UNITS - 1)\
+        # large groups are split into slices, each with its own sum,
+        # input and threshold cores, and slices into partitions (blocks)
+        _slices = (self.units + MLPConstants.MAX_SLICE_UNITS - 1)\
+            // MLPConstants.MAX_SLICE_UNITS
+        _slice_units = (self.units + _slices - 1) // _slices
+
+        # number of partitions in every slice
+        self.slice_parts = (_slice_units + MLPConstants.MAX_BLK_UNITS - 1)\
             // MLPConstants.MAX_BLK_UNITS
 
+        # units per partition (block) - balanced across partitions
+        self.blk_units = (_slice_units + self.slice_parts - 1)\
+            // self.slice_parts
+
+        # number of partitions and slices required for this group
+        self.partitions = (self.units + self.blk_units - 1)\
+            // self.blk_units
+        self.slices = (self.partitions + self.slice_parts - 1)\
+            // self.slice_parts
+
         if self.partitions == 1:
             print (f"creating group {self.label} with 1 partition")
         else:
@@ -36,6 +52,10 @@ class MLPGroup():
                    f"{self.partitions} partitions"
                    )
 
+        if self.slices > 1:
+            print (f"splitting group {self.label} into "
+                   f"{self.slices} slices")
+
         # keep track of associated incoming links
         self.links_from = []
 
@@ -48,11 +68,13 @@ class MLPGroup():
         # group has no targets
         self.targets = []
 
-        # keep track of associated vertices
+        # keep track of associated vertices (s, i and t: one per slice,
+        # s reduction tree nodes: any number per slice)
         self.w_vertices = []
-        self.s_vertex   = None
-        self.i_vertex   = None
-        self.t_vertex   = None
+        self.s_vertices = []
+        self.s_tree_vertices = []
+        self.i_vertices = []
+        self.t_vertices = []
 
         # group function parameters
         self.output_grp = (MLPGroupTypes.OUTPUT in self.type)
@@ -154,3 +176,40 @@ class MLPGroup():
                 self.group_criterion    = MLPConstants.DEF_GRP_CRIT
                 self.criterion_function = MLPStopCriteria.STOP_STD
                 self.error_function     = MLPErrorFuncs.ERR_CROSS_ENTROPY
+
+
+    def slice_of (self, partition):
+        """ slice that contains a partition
+        """
+        return partition // self.slice_parts
+
+
+    def slice_base (self, slc):
+        """ index of the first unit of a slice
+        """
+        return slc * self.slice_parts * self.blk_units
+
+
+    def slice_units (self, slc):
+        """ number of units in a slice
+        """
+        return min (self.slice_parts * self.blk_units,
+                    self.units - self.slice_base (slc))
+
+
+    def slice_partitions (self, slc):
+        """ number of partitions in a slice
+        """
+        return min (self.slice_parts,
+                    self.partitions - slc * self.slice_parts)
+
+
+    def slice_data (self, data, slc):
+        """ per-unit data (inputs or targets, stored as consecutive
+            blocks of one value per unit) of the units of a slice
+        """
+        _base  = self.slice_base (slc)
+        _units = self.slice_units (slc)
+
+        return [v for b in range (0, len (data), self.units)
+                for v in data[b + _base : b + _base + _units]]
@@ -0,0 +1,320 @@
+import os
+import shutil
+import struct
+import subprocess
+import tempfile
+
+from spinn_pdp2.input_vertex     import InputVertex
+from spinn_pdp2.sum_vertex       import SumVertex
+from spinn_pdp2.threshold_vertex import ThresholdVertex
+from spinn_pdp2.weight_vertex    import WeightVertex
+from spinn_pdp2.mlp_types        import MLPConstants, MLPRegions
+
+
+class MLPHostSpec ():
+    """ collects the SDRAM regions written by a vertex
+
+        implements the subset of the data specification
+        interface used by the MLP vertices
+    """
+
+    def __init__(self):
+        self._regions = {}
+        self._focus   = None
+
+    def reserve_memory_region (self, region, size, label = None):
+        self._regions[region] = bytearray ()
+
+    def switch_write_focus (self, region):
+        self._focus = self._regions[region]
+
+    def write_value (self, data, data_type = None):
+        # default data type is a 32-bit word
+        if data_type is None:
+            _size = 4
+        else:
+            _size = data_type.size
+
+        self._focus += (int (data) & ((1 << (8 * _size)) - 1)).to_bytes (
+            _size, "little")
+
+    def write_array (self, array, data_type = None):
+        for v in array:
+            self.write_value (v, data_type)
+
+    def end_specification (self):
+        self._focus = None
+
+    def region (self, region):
+        return bytes (self._regions.get (region, b""))
+
+
+class MLPHostRoutingInfo ():
+    """ allocates one key space per outgoing (vertex, partition) pair
+
+        keys follow the KEY_SPACE_SIZE used by every MLP vertex,
+        i.e., key = partition index << 16
+    """
+
+    def __init__(self):
+        self._keys = {}
+
+    def get_first_key_from_pre_vertex (self, vertex, partition):
+        if (vertex, partition) not in self._keys:
+            self._keys[(vertex, partition)] = \
+                len (self._keys) * MLPConstants.KEY_SPACE_SIZE
+        return self._keys[(vertex, partition)]
+
+    @property
+    def keys (self):
+        return self._keys
+
+
+class MLPHostSimulator ():
+    """ runs the MLP cores natively on the host
+
+        the machine graph (vertices, SDRAM regions and multicast routes)
+        is written to a graph file and executed stage by stage by the
+        mlp_host multicast-fabric simulator (c_code/host.mk)
+
+        the cores of every round are shared by a pool of worker threads,
+        results do not depend on the number of threads
+
+        tx_rate (if not 0) limits the packets a core can send per round,
+        to model a congested router: cores then queue outbound packets
+        and the cores that had to do so are reported after every stage
+    """
+
+    # graph file identification
+    GRAPH_MAGIC   = 0x48504c4d
+    GRAPH_VERSION = 1
+
+    # core types (mlp_params.h)
+    WEIGHT_PROC    = 0
+    SUM_PROC       = 1
+    THRESHOLD_PROC = 2
+    INPUT_PROC     = 3
+
+    def __init__(self, network, threads = 1, tx_rate = 0):
+        self._network  = network
+        self._threads  = threads
+        self._tx_rate  = tx_rate
+        self._vertices = []
+        self._edges    = []
+
+        self._sim      = None
+        self._work_dir = None
+
+        # recorded data, kept until reset (as the buffer manager)
+        self._recordings = {}
+
+        # statistics of the last stage run
+        self.stats = {}
+
+        # outbound queue statistics of the last stage run:
+        # {vertex label: (refused sends, queue high-water mark)}
+        self.tx_stats = {}
+
+        # path to host binaries
+        self._binaries_path = os.path.join (os.path.dirname (__file__),
+                                            "..", "binaries", "host")
+
+    def add_vertex (self, vertex):
+        self._vertices.append (vertex)
+
+    def add_edge (self, pre_vertex, post_vertex, partition):
+        self._edges.append ((pre_vertex, post_vertex, partition))
+
+    def _core_type (self, vertex):
+        if isinstance (vertex, WeightVertex):
+            return self.WEIGHT_PROC
+        if isinstance (vertex, SumVertex):
+            return self.SUM_PROC
+        if isinstance (vertex, InputVertex):
+            return self.INPUT_PROC
+        return self.THRESHOLD_PROC
+
+    def _write_graph (self, graph_file):
+        """ writes cores, their SDRAM regions and multicast routes
+
+            all values are little-endian 32-bit words,
+            byte blocks are padded to a whole number of words
+        """
+        _routing_info = MLPHostRoutingInfo ()
+
+        # generate the SDRAM regions of every vertex
+        _regions = []
+        for v in self._vertices:
+            _spec = MLPHostSpec ()
+            if isinstance (v, ThresholdVertex):
+                # recording channels are unbounded on the host
+                v.write_data_regions (_spec, _routing_info, 0)
+            else:
+                v.write_data_regions (_spec, _routing_info)
+            _regions.append (_spec)
+
+        # collect the destinations of every partition
+        _index = {v: i for i, v in enumerate (self._vertices)}
+        _dests = {}
+        for (pre, post, part) in self._edges:
+            _key = _routing_info.get_first_key_from_pre_vertex (pre, part)
+            _dests.setdefault (_key, [])
+            if _index[post] not in _dests[_key]:
+                _dests[_key].append (_index[post])
+
+        _mask = (~(MLPConstants.KEY_SPACE_SIZE - 1)) & 0xffffffff
+        _keys = sorted (_routing_info.keys.values ())
+
+        def _block (data):
+            return data + bytes ((-len (data)) % 4)
+
+        with open (graph_file, "wb") as f:
+            f.write (struct.pack ("<4I", self.GRAPH_MAGIC,
+                                  self.GRAPH_VERSION,
+                                  len (self._vertices), len (_keys)))
+
+            for v, _spec in zip (self._vertices, _regions):
+                _label = v.label.encode ()
+                f.write (struct.pack ("<2I", self._core_type (v),
+                                      len (_label)))
+                f.write (_block (_label))
+
+                f.write (struct.pack ("<I", len (MLPRegions)))
+                for r in MLPRegions:
+                    _data = _spec.region (r.value)
+                    f.write (struct.pack ("<I", len (_data)))
+                    f.write (_block (_data))
+
+            for _key in _keys:
+                _d = _dests.get (_key, [])
+                f.write (struct.pack (f"<3I{len (_d)}I",
+                                      _key, _mask, len (_d), *_d))
+
+    def load (self):
+        """ write the graph file and start the simulator
+        """
+        _exe = os.path.join (self._binaries_path, "mlp_host")
+        if not os.path.isfile (_exe):
+            print (f"error: cannot find host simulator {_exe}")
+            print ("build it with 'make host' in c_code")
+            return False
+
+        self._work_dir = tempfile.mkdtemp (prefix = "mlp_host_")
+        _graph_file = os.path.join (self._work_dir, "graph.bin")
+        self._write_graph (_graph_file)
+
+        print (f"loading {len (self._vertices)} cores into host simulator")
+
+        self._sim = subprocess.Popen (
+            [_exe, "-t", str (self._threads), "-r", str (self._tx_rate),
+             "-o", self._work_dir, _graph_file],
+            stdin = subprocess.PIPE, stdout = subprocess.PIPE,
+            universal_newlines = True
+            )
+
+        return True
+
+    def run_stage (self, stage_config):
+        """ run one stage to completion
+
+        :return: True if every core finished without error
+        """
+        if self._sim is None and not self.load ():
+            return False
+
+        self._sim.stdin.write (f"run {stage_config.hex ()}\n")
+        self._sim.stdin.flush ()
+
+        self.tx_stats = {}
+
+        while True:
+            _line = self._sim.stdout.readline ()
+            if not _line:
+                print ("error: host simulator exited unexpectedly")
+                self._sim = None
+                return False
+
+            _fields = _line.split ()
+
+            # collect recorded data
+            if _fields[0] == "rec":
+                _v = self._vertices[int (_fields[1])]
+                _ch = int (_fields[2])
+                with open (_fields[3], "rb") as f:
+                    self._recordings[(_v, _ch)] = \
+                        self._recordings.get ((_v, _ch), b"") + f.read ()
+                os.remove (_fields[3])
+
+            # cores that had to queue outbound packets
+            elif _fields[0] == "tx":
+                _v = self._vertices[int (_fields[1])]
+                self.tx_stats[_v.label] = (int (_fields[2]),
+                                           int (_fields[3]))
+
+            # and stage statistics
+            elif _fields[0] == "stage":
+                _status = _fields[2]
+                self.stats = {k: int (v) for k, v in
+                              (f.split ("=") for f in _fields[3:])}
+                break
+
+        self._report ()
+
+        if _status != "ok":
+            print (f"error: host stage {_fields[1]} finished with {_status}")
+            return False
+
+        return True
+
+    def _report (self):
+        """ report ticks and packets per example
+
+            every sum core sends one sync packet per example and
+            the last OUTPUT group sends one stop packet per tick
+        """
+        _s_cores = sum (1 for v in self._vertices
+                        if isinstance (v, SumVertex) and not v.is_tree_node)
+        _examples = self.stats["sync"] // max (_s_cores, 1)
+        self.stats["examples"] = _examples
+
+        print ("\n--------------------------------------------------")
+        print (f"host run: {self.stats['rounds']} rounds, "
+               f"{self.stats['stop']} ticks, "
+               f"{self.stats['sent']} packets sent, "
+               f"{self.stats['delivered']} delivered")
+        if _examples:
+            print (f"per example: {self.stats['stop'] / _examples:.1f} ticks, "
+                   f"{self.stats['sent'] / _examples:.1f} packets sent, "
+                   f"{self.stats['delivered'] / _examples:.1f} delivered")
+        if self.tx_stats:
+            print (f"tx refused sends: {self.stats['tx_refused']}, "
+                   f"max queue depth: {self.stats['tx_hwm']}, worst cores:")
+            for _label, (_refused, _hwm) in sorted (
+                    self.tx_stats.items (), key = lambda x: -x[1][0])[:5]:
+                print (f"  {_label}: {_refused} refused sends, max depth {_hwm}")
+        print ("--------------------------------------------------\n")
+
+    def read (self, vertex, channel):
+        """ get recorded data
+
+        :return: recorded data as packed bytes
+        """
+        return self._recordings.get ((vertex, channel), b"")
+
+    def reset (self):
+        """ discard recorded data
+        """
+        self._recordings = {}
+
+    def stop (self):
+        """ stop the simulator and clean up
+        """
+        if self._sim is not None:
+            self._sim.stdin.write ("quit\n")
+            self._sim.stdin.close ()
+            self._sim.wait ()
+            self._sim = None
+
+        if self._work_dir is not None:
+            shutil.rmtree (self._work_dir, ignore_errors = True)
+            self._work_dir = None
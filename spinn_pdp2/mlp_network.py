@@ -10,10 +10,12 @@ from spinn_pdp2.sum_vertex       import SumVertex
 from spinn_pdp2.threshold_vertex import ThresholdVertex
 from spinn_pdp2.weight_vertex    import WeightVertex
 from spinn_pdp2.mlp_types        import MLPGroupTypes, MLPConstants, \
-    MLPVarSizeRecordings, MLPConstSizeRecordings, MLPExtraRecordings
+    MLPVarSizeRecordings, MLPConstSizeRecordings, MLPExtraRecordings, \
+    MLPBackends, MLPStopCriteria
 from spinn_pdp2.mlp_group        import MLPGroup
 from spinn_pdp2.mlp_link         import MLPLink
 from spinn_pdp2.mlp_examples     import MLPExampleSet
+from spinn_pdp2.mlp_host         import MLPHostSimulator
 
 
 class MLPNetwork():
@@ -26,13 +28,59 @@ class MLPNetwork():
                 net_type,
                 intervals = 1,
                 ticks_per_interval = 1,
+                backend = MLPBackends.SPINNAKER,
+                host_threads = 1,
+                host_tx_rate = 0,
+                threshold_only_sources = False,
+                sum_fan_in = 0,
+                lds_fan_in = 0,
+                crit_fan_in = 1
                 ):
         """
+        :param backend: run on SpiNNaker or on the host simulator
+        :param host_threads: host simulator worker threads
+        :param host_tx_rate: host simulator packets per core and round \
+                             (default: 0, no limit)
+        :param threshold_only_sources: map groups that receive no links \
+                                       to a threshold core only
+        :param sum_fan_in: max partial sums per unit and tick accumulated \
+                           by a sum core, using a reduction tree of sum \
+                           cores if required (default: 0, no tree)
+        :param lds_fan_in: children per sum core in the link delta \
+                           summation tree (default: 0, all sum cores \
+                           report to the first one)
+        :param crit_fan_in: children per OUTPUT group threshold core in \
+                            the stop criterion tree (default: 1, a daisy \
+                            chain in output_chain order)
+
+        :type backend: enum MLPBackends
+        :type host_threads: integer
+        :type host_tx_rate: integer
+        :type threshold_only_sources: boolean
+        :type sum_fan_in: integer
+        :type lds_fan_in: integer
+        :type crit_fan_in: integer
         """
         # assign network parameter values from arguments
         self._net_type           = net_type.value
         self._intervals          = intervals
         self._ticks_per_interval = ticks_per_interval
+        self._backend            = backend
+        self._host_threads       = host_threads
+        self._host_tx_rate       = host_tx_rate
+        self._thld_only_sources  = threshold_only_sources
+        self._sum_fan_in         = sum_fan_in
+
+        if sum_fan_in == 1:
+            print ("error: sum_fan_in must be at least 2 - no reduction tree")
+            self._sum_fan_in = 0
+
+        self._lds_fan_in = lds_fan_in
+
+        self._crit_fan_in = crit_fan_in
+        if crit_fan_in < 1:
+            print ("error: crit_fan_in must be at least 1 - using a chain")
+            self._crit_fan_in = 1
 
         # default network parameter values
         self._global_max_ticks = (intervals * ticks_per_interval) + 1
@@ -42,6 +90,9 @@ class MLPNetwork():
         self._weight_decay     = MLPConstants.DEF_WEIGHT_DECAY
         self._momentum         = MLPConstants.DEF_MOMENTUM
         self._update_function  = MLPConstants.DEF_UPDATE_FUNC
+        self._weight_format    = MLPConstants.DEF_WEIGHT_FORMAT
+        self._packed           = False
+        self._fixed_ticks      = False
         self._num_updates      = MLPConstants.DEF_NUM_UPDATES
         self._num_examples     = None
 
@@ -75,7 +126,8 @@ class MLPNetwork():
         # initialise example set
         self._ex_set = None
 
-        # create single-unit Bias group by default
+        # create single-unit Bias group by default - it has no cores,
+        # bias weights are held by the weight cores of the linked groups
         self._bias_group = self.group (units        = 1,
                                        group_type   = [MLPGroupTypes.BIAS],
                                        label        = "Bias"
@@ -83,6 +135,9 @@ class MLPNetwork():
 
         # initialise machine graph parameters
         self._graph_rdy = False
+
+        # host simulator (if running on the host)
+        self._host = None
         
         # keep track of the number of vertices in the graph
         self._num_vertices = 0
@@ -121,6 +176,10 @@ class MLPNetwork():
     def global_max_ticks (self):
         return self._global_max_ticks
 
+    @property
+    def fixed_ticks (self):
+        return self._fixed_ticks
+
     @property
     def rec_test_results (self):
         return self._rec_test_results
@@ -153,6 +212,8 @@ class MLPNetwork():
             typedef struct network_conf
             {
               uchar net_type;
+              uchar packed;
+              uchar fixed_ticks;
               uint  ticks_per_int;
               uint  global_max_ticks;
               uint  num_write_blks;
@@ -161,8 +222,10 @@ class MLPNetwork():
             pack: standard sizes, little-endian byte order,
             explicit padding
         """
-        return struct.pack("<B3x3I",
+        return struct.pack("<3Bx3I",
                            self._net_type,
+                           self._packed,
+                           self._fixed_ticks,
                            self._ticks_per_interval,
                            self._global_max_ticks,
                            self._num_write_blks
@@ -371,7 +434,9 @@ class MLPNetwork():
              test_group_crit  = None,
              learning_rate    = None,
              weight_decay     = None,
-             momentum         = None
+             momentum         = None,
+             weight_format    = None,
+             packed_transport = None
              ):
         """ set a network parameter to the given value
 
@@ -381,6 +446,10 @@ class MLPNetwork():
         :param learning_rate: amount used to scale deltas when updating weights
         :param weight_decay: amount by which weights are scaled after being updated
         :param momentum: the carryover of previous weight changes to the new step
+        :param weight_format: weight storage in the weight cores \
+                              (WEIGHT_16 halves weight memory, |w| < 4)
+        :param packed_transport: send unit outputs and deltas to the \
+                                 weight cores as pairs of 16-bit values
 
         :type num_updates: unsigned integer
         :type train_group_crit: float
@@ -388,6 +457,8 @@ class MLPNetwork():
         :type learning_rate: float
         :type weight_decay: float
         :type momentum: float
+        :type weight_format: enum MLPWeightFormats
+        :type packed_transport: boolean
         """
         if num_updates is not None:
             print (f"setting num_updates to {num_updates}")
@@ -413,6 +484,20 @@ class MLPNetwork():
             print (f"setting momentum to {momentum}")
             self._momentum = momentum
 
+        if weight_format is not None:
+            if self._graph_rdy:
+                print ("error: weight format must be set before the network runs")
+            else:
+                print (f"setting weight_format to {weight_format.name}")
+                self._weight_format = weight_format
+
+        if packed_transport is not None:
+            if self._graph_rdy:
+                print ("error: packed transport must be set before the network runs")
+            else:
+                print (f"setting packed_transport to {packed_transport}")
+                self._packed = int (packed_transport)
+
 
     def recording_options (self,
              rec_test_results           = None,
@@ -602,20 +687,30 @@ class MLPNetwork():
 
                 # retrieve recorded tick_data from first output group
                 g = self.out_grps[0]
-                rec_tick_data = g.t_vertex.read (
-                    gfe.placements().get_placement_of_vertex (g.t_vertex),
-                    gfe.buffer_manager(), MLPExtraRecordings.TICK_DATA.value
+                rec_tick_data = self._read_recording (
+                    g.t_vertices[0], MLPExtraRecordings.TICK_DATA.value
                     )
 
                 TOTAL_TICKS = len (rec_tick_data) // TICK_DATA_SIZE
 
-                # retrieve recorded outputs from every output group
+                # retrieve recorded outputs from every output group,
+                # interleaving the tick outputs of its slices
                 rec_outputs = [None] * len (self.out_grps)
                 for g in self.out_grps:
-                    rec_outputs[g.write_blk] = g.t_vertex.read (
-                        gfe.placements().get_placement_of_vertex (g.t_vertex),
-                        gfe.buffer_manager(), MLPVarSizeRecordings.OUTPUTS.value
-                        )
+                    _recs = [self._read_recording (
+                        t, MLPVarSizeRecordings.OUTPUTS.value
+                        ) for t in g.t_vertices]
+
+                    if g.slices == 1:
+                        rec_outputs[g.write_blk] = _recs[0]
+                        continue
+
+                    _sizes = [2 * g.slice_units (s) for s in range (g.slices)]
+                    _ticks = min (len (r) // sz for r, sz in zip (_recs, _sizes))
+                    rec_outputs[g.write_blk] = b"".join (
+                        r[tk * sz : (tk + 1) * sz]
+                        for tk in range (_ticks)
+                        for r, sz in zip (_recs, _sizes))
 
                 # compute total ticks in first example
                 #TODO: need to get actual value from simulation, not max value
@@ -696,7 +791,10 @@ class MLPNetwork():
                                 f.write ("{:8.6f} {}\n".format (out, tgt))
 
             # prepare buffers for next stage
-            gfe.buffer_manager().reset()
+            if self._host is not None:
+                self._host.reset ()
+            else:
+                gfe.buffer_manager().reset()
 
 
     def show_test_results (self):
@@ -724,11 +822,10 @@ class MLPNetwork():
             TEST_RESULTS_FORMAT = "<4I"
             TEST_RESULTS_SIZE = struct.calcsize(TEST_RESULTS_FORMAT)
 
-            # retrieve recorded tick_data from last output group
+            # retrieve recorded test results from last output group
             g = self.out_grps[-1]
-            rec_test_results = g.t_vertex.read (
-                gfe.placements().get_placement_of_vertex (g.t_vertex),
-                gfe.buffer_manager(), MLPConstSizeRecordings.TEST_RESULTS.value
+            rec_test_results = self._read_recording (
+                g.t_vertices[-1], MLPConstSizeRecordings.TEST_RESULTS.value
                 )
 
             if len (rec_test_results) >= TEST_RESULTS_SIZE:
@@ -743,157 +840,421 @@ class MLPNetwork():
                 print ("--------------------------------------------------\n")
 
 
+    def _read_recording (self, vertex, channel):
+        """ get the data recorded by a vertex in a channel
+        """
+        if self._host is not None:
+            return self._host.read (vertex, channel)
+
+        return vertex.read (
+            gfe.placements().get_placement_of_vertex (vertex),
+            gfe.buffer_manager(), channel
+            )
+
+
+    def _add_vertex (self, vertex):
+        """ adds a vertex to the machine graph
+        """
+        if self._host is not None:
+            self._host.add_vertex (vertex)
+        else:
+            gfe.add_machine_vertex_instance (vertex)
+        self._num_vertices += 1
+
+
+    def _add_edge (self, pre_vertex, post_vertex, partition):
+        """ adds an edge to the machine graph
+        """
+        if self._host is not None:
+            self._host.add_edge (pre_vertex, post_vertex, partition)
+        else:
+            gfe.add_machine_edge_instance (MachineEdge (pre_vertex,
+                                                        post_vertex),
+                                           partition)
+
+
+    def threshold_only (self, grp):
+        """ checks if grp is served by its threshold core alone
+
+            with threshold_only_sources, a group that receives no links
+            and has no input pipeline has zero nets on every tick. It gets
+            no weight, sum or input cores: its threshold core paces its
+            own FORWARD ticks and receives the errors directly from the
+            weight cores of the groups it feeds. OUTPUT groups and groups
+            that feed no other group keep all their cores.
+        """
+        return (self._thld_only_sources
+                and not grp.links_from
+                and grp.num_in_procs == 0
+                and not grp.output_grp
+                and any (grp in g.links_from for g in self.groups))
+
+
+    def core_groups (self):
+        """ groups mapped to cores, in network order
+
+            the Bias group gets no cores: bias weights are folded
+            into the weight cores of the groups it links to
+        """
+        return [g for g in self.groups if g != self.bias_group]
+
+
+    def s_groups (self):
+        """ groups served by a sum core, in network order
+
+            the first one is the root of the link delta summation
+        """
+        return [g for g in self.core_groups ()
+                if not self.threshold_only (g)]
+
+
+    def w_from_groups (self, grp):
+        """ groups that need weight cores towards grp
+
+            only linked groups need weight cores. A group with no incoming
+            or no outgoing links gets all-zero weight cores from itself,
+            so that its sum core still receives partial nets and errors.
+            Threshold-only groups and the Bias group get no weight cores
+            and Bias links need none (see core_groups).
+
+        :return: list of groups, in network order
+        """
+        if grp == self.bias_group or self.threshold_only (grp):
+            return []
+
+        _links_from = [g for g in grp.links_from if g != self.bias_group]
+
+        _to_self = (not _links_from) or \
+            not any (grp in g.links_from for g in self.groups)
+
+        return [g for g in self.core_groups ()
+                if (g in _links_from) or (g == grp and _to_self)]
+
+
+    def _reduction_tree (self, sources):
+        """ arranges sources as the leaves of a reduction tree
+            with a fan-in of sum_fan_in
+
+        :return: (nodes, top): the children of every tree node, from the
+                 leaves up, and the children of the root. A child is a
+                 source or the (integer) index of a tree node
+        """
+        nodes = []
+        level = sources
+        while len (level) > self._sum_fan_in:
+            _next = []
+            for i in range (0, len (level), self._sum_fan_in):
+                nodes.append (level[i:i + self._sum_fan_in])
+                _next.append (len (nodes) - 1)
+            level = _next
+
+        return (nodes, level)
+
+
+    def _map_sum_tree (self, grp, slc, fwd_dest, bkp_dest):
+        """ creates the reduction tree of the sum core of a group slice
+
+            every unit receives one partial net from each (from_group,
+            row_blk) pair of w cores and one partial error from each
+            (group, col_blk) pair. With more than sum_fan_in of them,
+            they are gathered by tree nodes (intermediate sum cores).
+            FORWARD and BACKPROP trees share the tree nodes: node n of
+            either tree is mapped to the same sum core.
+
+            fwd_dest and bkp_dest collect the tree nodes
+            that w cores must send to (default: slice sum core)
+        """
+        _root = grp.s_vertices[slc]
+
+        # partial net sources,
+        _fwd_src = {}
+        for w in grp.w_vertices:
+            if w.col_slice == slc:
+                _fwd_src.setdefault ((w.from_group.id, w.row_blk),
+                                     []).append (w)
+
+        # partial error sources,
+        _bkp_src = {}
+        for g in self.core_groups ():
+            for w in g.w_vertices:
+                if w.from_group == grp and w.row_slice == slc:
+                    _bkp_src.setdefault ((g.id, w.col_blk), []).append (w)
+
+        # and their reduction trees
+        _fwd_nodes, _fwd_top = \
+            self._reduction_tree (list (_fwd_src.values ()))
+        _bkp_nodes, _bkp_top = \
+            self._reduction_tree (list (_bkp_src.values ()))
+
+        _tree = []
+        for n in range (max (len (_fwd_nodes), len (_bkp_nodes))):
+            sv = SumVertex (self, grp, slc, tree_node = n)
+            sv.fwd_expect = len (_fwd_nodes[n]) if n < len (_fwd_nodes) else 0
+            sv.bkp_expect = len (_bkp_nodes[n]) if n < len (_bkp_nodes) else 0
+            grp.s_tree_vertices.append (sv)
+            self._add_vertex (sv)
+            _tree.append (sv)
+
+        if _tree:
+            print (f"Creating {len (_tree)} tree nodes for {_root.label}")
+
+        # the root only expects the partial sums of its children
+        _root.fwd_expect = len (_fwd_top)
+        _root.bkp_expect = len (_bkp_top)
+
+        # create tree node to parent links
+        # and collect the parents of the w cores
+        for (nodes, top, dest, link) in (
+                (_fwd_nodes, _fwd_top, fwd_dest, "fwd_link"),
+                (_bkp_nodes, _bkp_top, bkp_dest, "bkp_link")):
+            _parents = [(_tree[n], c) for n in range (len (nodes))
+                        for c in nodes[n]]
+            _parents += [(_root, c) for c in top]
+
+            for (parent, c) in _parents:
+                if isinstance (c, int):
+                    self._add_edge (_tree[c], parent,
+                                    getattr (_tree[c], link))
+                else:
+                    for w in c:
+                        dest[w] = parent
+
+
     def generate_machine_graph (self):
         """ generates a machine graph for the application graph
         """
         print ("generating machine graph")
 
-        # path to binary files
-        binaries_path = os.path.join(os.path.dirname(__file__), "..", "binaries")
+        if self._backend == MLPBackends.HOST:
+            # setup the host simulator
+            if self._host is not None:
+                self._host.stop ()
 
-        # setup the machine graph
-        gfe.setup (model_binary_folder = binaries_path)
+            self._host = MLPHostSimulator (self, self._host_threads,
+                                           self._host_tx_rate)
+        else:
+            # path to binary files
+            binaries_path = os.path.join(os.path.dirname(__file__), "..", "binaries")
+
+            # setup the machine graph
+            gfe.setup (model_binary_folder = binaries_path)
 
         # set the number of write blocks before generating vertices
         self._num_write_blks = len (self.output_chain)
 
+        # with no stop criterion in any OUTPUT group every event runs for
+        # its maximum time: the s, i and t cores then make the tick stop
+        # decisions locally and only the cores that start the ticks (w
+        # and threshold-only t cores) wait for the tick stop packet,
+        # which paces the network
+        self._fixed_ticks = int (all (
+            g.criterion_function == MLPStopCriteria.STOP_NONE
+            for g in self.output_chain))
+
         # compute number of partitions
-        for grp in self.groups:
+        for grp in self.core_groups ():
             self.partitions = self.partitions + grp.partitions
 
         # create associated weight, sum, input and threshold
         # machine vertices for every network group
-        for grp in self.groups:
+        for grp in self.core_groups ():
             # create one weight core per partition
-            # of every (from_group, group) pair
-            # NOTE: all-zero cores can be optimised out
-            for from_grp in self.groups:
+            # of every linked (from_group, group) pair
+            for from_grp in self.w_from_groups (grp):
                 for _tp in range (grp.partitions):
                     for _fp in range (from_grp.partitions):
                         wv = WeightVertex (self, grp, from_grp, _tp, _fp)
                         grp.w_vertices.append (wv)
-                        gfe.add_machine_vertex_instance (wv)
-                        self._num_vertices += 1
-
-            # create one sum core per group
-            sv = SumVertex (self, grp)
-            grp.s_vertex = sv
-            gfe.add_machine_vertex_instance (sv)
-            self._num_vertices += 1
-
-            # create one input core per group
-            iv = InputVertex (self, grp)
-            grp.i_vertex = iv
-            gfe.add_machine_vertex_instance (iv)
-            self._num_vertices += 1
-
-            # create one threshold core per group
-            tv = ThresholdVertex (self, grp)
-            grp.t_vertex = tv
-            gfe.add_machine_vertex_instance (tv)
-            self._num_vertices += 1
+                        self._add_vertex (wv)
+
+            # create one sum and one input core per group slice,
+            # unless served by the threshold core alone
+            for _sl in range (grp.slices):
+                if not self.threshold_only (grp):
+                    sv = SumVertex (self, grp, _sl)
+                    grp.s_vertices.append (sv)
+                    self._add_vertex (sv)
+
+                    iv = InputVertex (self, grp, _sl)
+                    grp.i_vertices.append (iv)
+                    self._add_vertex (iv)
+
+                # create one threshold core per group slice
+                tv = ThresholdVertex (self, grp, _sl)
+                grp.t_vertices.append (tv)
+                self._add_vertex (tv)
+
+        # arrange the sum cores of high fan-in group slices
+        # in reduction trees -- w cores may send to tree nodes
+        _fwd_dest = {}
+        _bkp_dest = {}
+        if self._sum_fan_in:
+            for grp in self.s_groups ():
+                for _sl in range (grp.slices):
+                    self._map_sum_tree (grp, _sl, _fwd_dest, _bkp_dest)
+
+        # the t cores of the OUTPUT group slices form the stop criterion
+        # tree, rooted at the last one - the max criterion needs the whole
+        # group, so the slices of such a group are chained instead, and
+        # only the last one joins the tree
+        _chain = [t for g in self.output_chain for t in g.t_vertices]
+        _crit_nodes = [t for g in self.output_chain for t in g.t_vertices
+                       if t == g.t_vertices[-1] or
+                       g.criterion_function != MLPStopCriteria.STOP_MAX]
 
         # create associated forward, backprop, link delta summation,
         # synchronisation and stop machine edges for every network group
-        first = self.groups[0]
-        for grp in self.groups:
+        first = self.s_groups ()[0].s_vertices[0]
+        for grp in self.core_groups ():
             for w in grp.w_vertices:
                 _frmg = w.from_group
+                _sv   = grp.s_vertices[w.col_slice]
+                _iv   = grp.i_vertices[w.col_slice]
+                _ftv  = _frmg.t_vertices[w.row_slice]
 
                 # create forward w to s links
-                gfe.add_machine_edge_instance (MachineEdge (w, grp.s_vertex),
-                                             w.fwd_link)
+                self._add_edge (w, _fwd_dest.get (w, _sv),
+                                w.fwd_link)
 
                 # create forward t to w (multicast) links
-                gfe.add_machine_edge_instance (MachineEdge (_frmg.t_vertex, w),
-                                             _frmg.t_vertex.fwd_link[w.row_blk])
-
-                # create backprop w to s links
-                gfe.add_machine_edge_instance (MachineEdge (w, _frmg.s_vertex),
-                                             w.bkp_link)
+                self._add_edge (_ftv, w,
+                                _ftv.fwd_link[w.row_blk % _frmg.slice_parts])
+
+                # create backprop w to s links - errors go straight
+                # to the t core of threshold-only groups
+                if self.threshold_only (_frmg):
+                    self._add_edge (w, _ftv,
+                                    w.bkp_link)
+                else:
+                    self._add_edge (w, _bkp_dest.get (
+                                        w, _frmg.s_vertices[w.row_slice]),
+                                    w.bkp_link)
 
                 # create backprop i to w (multicast) links
-                gfe.add_machine_edge_instance (MachineEdge (grp.i_vertex, w),
-                                             grp.i_vertex.bkp_link[w.col_blk])
+                self._add_edge (_iv, w,
+                                _iv.bkp_link[w.col_blk % grp.slice_parts])
 
                 # create link delta summation w to s links
-                gfe.add_machine_edge_instance (MachineEdge (w, grp.s_vertex),
-                                             w.lds_link)
+                self._add_edge (w, _sv,
+                                w.lds_link)
 
-                # create link delta summation result s (first) to w links
-                gfe.add_machine_edge_instance (MachineEdge (first.s_vertex, w),
-                                             first.s_vertex.lds_link)
+                # create link delta summation result s to w links
+                self._add_edge (_sv, w,
+                                _sv.ldr_link)
 
                 # create example synchronisation s to w (multicast) links
-                gfe.add_machine_edge_instance (MachineEdge (grp.s_vertex, w),
-                                               grp.s_vertex.fds_link)
-
-                if grp != _frmg:
-                    gfe.add_machine_edge_instance (MachineEdge (_frmg.s_vertex, w),
-                                                 _frmg.s_vertex.fds_link)
-
-            # create forward s to i link
-            gfe.add_machine_edge_instance (MachineEdge (grp.s_vertex,
-                                                      grp.i_vertex),
-                                         grp.s_vertex.fwd_link)
-
-            # create backprop s to t link
-            gfe.add_machine_edge_instance (MachineEdge (grp.s_vertex,
-                                                      grp.t_vertex),
-                                         grp.s_vertex.bkp_link)
-
-            # create forward i to t link
-            gfe.add_machine_edge_instance (MachineEdge (grp.i_vertex,
-                                                      grp.t_vertex),
-                                         grp.i_vertex.fwd_link)
-
-            # create backprop t to i link
-            gfe.add_machine_edge_instance (MachineEdge (grp.t_vertex,
-                                                      grp.i_vertex),
-                                         grp.t_vertex.bkp_link)
-
-            # create link delta summation s to s links - all s cores
-            # (except the first) send to the first s core
-            if grp != first:
-                print (f"Creating lds s-s edge from group {grp.label} "
-                       f"to group {first.label}")
-                gfe.add_machine_edge_instance (MachineEdge (grp.s_vertex,
-                                                          first.s_vertex),
-                                             grp.s_vertex.lds_link)
-
-            # create stop links, if OUTPUT group
-            if grp in self.output_chain:
-                # if last OUTPUT group broadcast stop decision
-                if grp == self.output_chain[-1]:
-                    for stpg in self.groups:
-                        # create stop links to all w cores
-                        for w in stpg.w_vertices:
-                            gfe.add_machine_edge_instance\
-                              (MachineEdge (grp.t_vertex, w),
-                               grp.t_vertex.stp_link)
-
-                        # create stop links to all s cores
-                        gfe.add_machine_edge_instance\
-                         (MachineEdge (grp.t_vertex, stpg.s_vertex),\
-                          grp.t_vertex.stp_link)
-
-                        # create stop links to all i cores
-                        gfe.add_machine_edge_instance\
-                         (MachineEdge (grp.t_vertex, stpg.i_vertex),\
-                          grp.t_vertex.stp_link)
-
-                        # create stop links to t cores (no link to itself!)
-                        if stpg != grp:
-                            gfe.add_machine_edge_instance\
-                             (MachineEdge (grp.t_vertex, stpg.t_vertex),\
-                              grp.t_vertex.stp_link)
-                else:
-                    # create stop link to next OUTPUT group in chain
-                    _inx  = self.output_chain.index (grp)
-                    _stpg = self.output_chain[_inx + 1]
-                    gfe.add_machine_edge_instance (MachineEdge (grp.t_vertex,
-                                                              _stpg.t_vertex),
-                                                 grp.t_vertex.stp_link)
+                self._add_edge (_sv, w,
+                                _sv.fds_link)
+
+                if not self.threshold_only (_frmg):
+                    _fsv = _frmg.s_vertices[w.row_slice]
+                    if _fsv != _sv:
+                        self._add_edge (_fsv, w,
+                                        _fsv.fds_link)
+
+            # threshold-only groups have no s or i core links
+            if self.threshold_only (grp):
+                continue
+
+            for sv, iv, tv in zip (grp.s_vertices, grp.i_vertices,
+                                   grp.t_vertices):
+                # create forward s to i link
+                self._add_edge (sv, iv,
+                                sv.fwd_link)
+
+                # create backprop s to t link
+                self._add_edge (sv, tv,
+                                sv.bkp_link)
+
+                # create forward i to t link
+                self._add_edge (iv, tv,
+                                iv.fwd_link)
+
+                # create backprop t to i link
+                self._add_edge (tv, iv,
+                                tv.bkp_link)
+
+        # create link delta summation s to s links - the s cores form
+        # a tree rooted at the first s core, with lds_fan_in children
+        # per s core (default: all send to the first s core). Totals
+        # go up the tree and the result is relayed down the tree
+        _lds_tree = [sv for g in self.s_groups () for sv in g.s_vertices]
+        for (n, sv) in enumerate (_lds_tree[1:], start = 1):
+            if self._lds_fan_in:
+                _parent = _lds_tree[(n - 1) // self._lds_fan_in]
+            else:
+                _parent = first
+
+            print (f"Creating lds s-s edge from {sv.label} "
+                   f"to {_parent.label}")
+            self._add_edge (sv, _parent,
+                            sv.lds_link)
+
+            self._add_edge (_parent, sv,
+                            _parent.ldr_link)
+
+            _parent.ldst_expect += 1
+
+        # create stop links along the max criterion chains - every slice
+        # sends its highest output and target values to the next one
+        for g in self.output_chain:
+            if g.criterion_function == MLPStopCriteria.STOP_MAX:
+                for (tv, _next) in zip (g.t_vertices, g.t_vertices[1:]):
+                    self._add_edge (tv, _next,
+                                    tv.stp_link)
+
+                    tv.crit_max_part = 1
+                    _next.crit_expect += 2
+
+        # create stop links along the OUTPUT criterion tree - every t core
+        # (except the last) sends to its parent, with crit_fan_in children
+        # per t core (default: a daisy chain to the next one)
+        _crit_tree = _crit_nodes[::-1]
+        for (n, tv) in enumerate (_crit_tree[1:], start = 1):
+            _parent = _crit_tree[(n - 1) // self._crit_fan_in]
+            self._add_edge (tv, _parent,
+                            tv.stp_link)
+
+            _parent.crit_expect += 1
+
+        # last element in chain broadcasts stop decisions - with fixed
+        # event durations the tick stop decision has its own links, only
+        # to the cores that start the ticks (the others make it locally)
+        _last = _chain[-1]
+        for stpg in self.core_groups ():
+            # create stop links to all w cores
+            for w in stpg.w_vertices:
+                self._add_edge (_last, w,
+                                _last.stp_link)
+
+                if self._fixed_ticks:
+                    self._add_edge (_last, w,
+                                    _last.tck_link)
+
+            # create stop links to all s (including tree nodes) and i cores
+            # - s cores that expect no partial nets start their own ticks
+            for v in stpg.s_vertices + stpg.s_tree_vertices:
+                self._add_edge (_last, v,
+                                _last.stp_link)
+
+                if self._fixed_ticks and v.fwd_expect == 0:
+                    self._add_edge (_last, v,
+                                    _last.tck_link)
+
+            for v in stpg.i_vertices:
+                self._add_edge (_last, v,
+                                _last.stp_link)
+
+            # create stop links to t cores (no link to itself!)
+            # - threshold-only groups start their own ticks
+            for v in stpg.t_vertices:
+                if v != _last:
+                    self._add_edge (_last, v,
+                                    _last.stp_link)
+
+                    if self._fixed_ticks and self.threshold_only (stpg):
+                        self._add_edge (_last, v,
+                                        _last.tck_link)
 
         self._graph_rdy = True
 
@@ -950,14 +1311,6 @@ class MLPNetwork():
         """
         self._aborted = False
 
-        # check that no group is too big
-        for grp in self.groups:
-            if grp.units > MLPConstants.MAX_GRP_UNITS:
-                print (f"run aborted: group {grp.label} has more than "
-                       f"{MLPConstants.MAX_GRP_UNITS} units.")
-                self._aborted = True
-                return
-
         # cannot run unless weights file exists
         if self._weights_file is None:
             print ("run aborted: weights file not given")
@@ -996,7 +1349,13 @@ class MLPNetwork():
             self.generate_machine_graph ()
 
         # run stage
-        gfe.run_until_complete (self._stage_id)
+        if self._host is not None:
+            if not self._host.run_stage (self.stage_config):
+                print ("run aborted: host simulator error")
+                self._aborted = True
+                return
+        else:
+            gfe.run_until_complete (self._stage_id)
 
         # show TEST RESULTS if available
         if self.rec_test_results and not self.training:
@@ -1018,5 +1377,8 @@ class MLPNetwork():
         """
         if not self._aborted:
             print ("exit: application finished")
-            # let the gfe clean up
-            gfe.stop()
+            # let the gfe (or the host simulator) clean up
+            if self._host is not None:
+                self._host.stop ()
+            else:
+                gfe.stop()
@@ -9,6 +9,13 @@ class MLPUpdateFuncs (Enum):
     UPD_DOUGSMOMENTUM = 2
 
 
+class MLPWeightFormats (Enum):
+    """ MLP weight core weight storage formats
+    """
+    WEIGHT_32 = 0
+    WEIGHT_16 = 1
+
+
 class MLPConstants ():
     """ MLP network constants
     """
@@ -17,6 +24,7 @@ class MLPConstants ():
     DEF_WEIGHT_DECAY = 0
     DEF_MOMENTUM = 0.9
     DEF_UPDATE_FUNC = MLPUpdateFuncs.UPD_DOUGSMOMENTUM
+    DEF_WEIGHT_FORMAT = MLPWeightFormats.WEIGHT_32
     DEF_NUM_UPDATES = 1
 
     DEF_INIT_NET  = 0
@@ -27,8 +35,13 @@ class MLPConstants ():
     MAX_IN_PROCS  = 2
     DEF_IN_PROCS  = 0
 
-    MAX_GRP_UNITS = 128
-    MAX_BLK_UNITS = 32
+    # largest slice of a group served by one sum, input and threshold
+    # core - larger groups are split into several slices
+    MAX_SLICE_UNITS = 128
+
+    # largest weight block (rows or columns): weights, weight changes
+    # and link deltas take 20 bytes of weight core DTCM per link
+    MAX_BLK_UNITS = 48
 
     MAX_OUT_PROCS = 5
     DEF_OUT_PROCS = 2
@@ -41,7 +54,7 @@ class MLPConstants ():
 
     # core configuration CONSTANTS
     KEY_SPACE_SIZE = 65536
-    NUM_KEYS_REQ   = 5
+    NUM_KEYS_REQ   = 7
 
     # MLP fixed-point fpreal type CONSTANTS
     FPREAL_SIZE      = 32
@@ -74,11 +87,27 @@ class MLPConstants ():
     WEIGHT_POS_EPSILON = 1
     WEIGHT_NEG_EPSILON = -1
 
+    # MLP fixed-point short_weight_t type CONSTANTS
+    # (16-bit weight storage: |w| < 4)
+    SHORT_WEIGHT_SHIFT = 13
+    SHORT_WEIGHT_MAX   = 0x7fff
+    SHORT_WEIGHT_MIN   = -SHORT_WEIGHT_MAX
+
     # weights file CONSTANTS
     LENS_WEIGHT_MAGIC_COOKIE = 1431655766
     WF_MAX = (1.0 * WEIGHT_MAX) / (1.0 * (1 << WEIGHT_SHIFT))
     WF_MIN = (1.0 * WEIGHT_MIN) / (1.0 * (1 << WEIGHT_SHIFT))
     WF_EPS = (1.0 * WEIGHT_POS_EPSILON) / (1.0 * (1 << WEIGHT_SHIFT))
+    SWF_MAX = (1.0 * SHORT_WEIGHT_MAX) / (1.0 * (1 << SHORT_WEIGHT_SHIFT))
+    SWF_MIN = (1.0 * SHORT_WEIGHT_MIN) / (1.0 * (1 << SHORT_WEIGHT_SHIFT))
+    SWF_EPS = (1.0 * WEIGHT_POS_EPSILON) / (1.0 * (1 << SHORT_WEIGHT_SHIFT))
+
+
+class MLPBackends (Enum):
+    """ MLP execution backends
+    """
+    SPINNAKER = 0
+    HOST      = 1
 
 
 class MLPNetworkTypes (Enum):
@@ -33,15 +33,34 @@ class SumVertex(
 
     """ A vertex to implement an PDP2 sum core
         that aggregates partial weight/input products
+        of one slice of a group
+
+        with a sum reduction tree (see MLPNetwork sum_fan_in) the
+        vertex can also be an intermediate node of the tree of a
+        group slice: it forwards partial sums to its parent sum core
+        and takes no part in example synchronisation or in the link
+        delta summation
     """
 
     def __init__(self,
                  network,
-                 group
+                 group,
+                 slc = 0,
+                 tree_node = None
                  ):
 
+        # slices of split groups are labelled with their index
+        if group.slices > 1:
+            _label = f"s_core{group.id}_{slc}"
+        else:
+            _label = f"s_core{group.id}"
+
+        # tree nodes are labelled with their index in the tree
+        if tree_node is not None:
+            _label = f"{_label}_r{tree_node}"
+
         super(SumVertex, self).__init__(
-            label = "s_core{}".format (group.id),
+            label = _label,
             binary_name = "sum.aplx",
             constraints = None)
 
@@ -50,11 +69,19 @@ class SumVertex(
         # application-level data
         self._network = network
         self._group   = group
+        self._slice   = slc
+        self._units   = group.slice_units (slc)
         self._set_cfg = network._ex_set.set_config
         self._ex_cfg  = network._ex_set.example_config
+        self._ev_cfg  = network._ex_set.event_config
+
+        # check if reduction tree node
+        self._is_tree_node = 0 if tree_node is None else 1
 
-        # check if first group in the network
-        if self.group.id == network.groups[0].id:
+        # check if first slice of the first group with sum cores
+        if self._is_tree_node:
+            self._is_first_group = 0
+        elif self.group.id == network.s_groups ()[0].id and slc == 0:
             self._is_first_group = 1
         else:
             self._is_first_group = 0
@@ -63,14 +90,24 @@ class SumVertex(
         self._fwd_link = "fwd_s{}".format (self.group.id)
         self._bkp_link = "bkp_s{}".format (self.group.id)
         self._lds_link = "lds_s{}".format (self.group.id)
+        self._ldr_link = "ldr_s{}".format (self.group.id)
         self._fds_link = "fds_s{}".format (self.group.id)
 
         # sum core-specific parameters
-        # NOTE: if all-zero w cores are optimised out these need reviewing
-        self._fwd_expect  = network.partitions
-        self._bkp_expect  = network.partitions
-        self._ldsa_expect = network.partitions * self.group.units
-        self._ldst_expect = len (network.groups) - 1
+        # one partial net per partition of every group with weight cores
+        # towards this group, one partial error per partition of every
+        # group with weight cores from this group
+        # (the mapper sets the expected partial sums of reduction trees
+        # and the children of the link delta summation tree)
+        self._fwd_expect  = sum (g.partitions
+                                 for g in network.w_from_groups (group))
+        self._bkp_expect  = sum (g.partitions for g in network.groups
+                                 if group in network.w_from_groups (g))
+        self._ldst_expect = 0
+        if self._is_tree_node:
+            self._ldsa_expect = 0
+        else:
+            self._ldsa_expect = self._fwd_expect * self._units
 
         # weight update function
         self.update_function = network._update_function
@@ -98,7 +135,16 @@ class SumVertex(
         self._N_EXAMPLES_BYTES = \
             len (self._ex_cfg) * len (self._ex_cfg[0])
 
+        # list of event configurations (only needed to make
+        # the tick stop decisions locally)
+        if network.fixed_ticks:
+            self._N_EVENTS_BYTES = \
+                len (self._ev_cfg) * len (self._ev_cfg[0])
+        else:
+            self._N_EVENTS_BYTES = 0
+
         # keys are integers
+        # (plus one key for the link delta summation result)
         self._N_KEYS_BYTES = MLPConstants.NUM_KEYS_REQ * _data_int.size
 
         # stage configuration structure
@@ -110,6 +156,7 @@ class SumVertex(
             self._N_CORE_CONFIGURATION_BYTES + \
             self._N_EXAMPLE_SET_BYTES + \
             self._N_EXAMPLES_BYTES + \
+            self._N_EVENTS_BYTES + \
             self._N_KEYS_BYTES + \
             self._N_STAGE_CONFIGURATION_BYTES
         )
@@ -118,6 +165,38 @@ class SumVertex(
     def group (self):
         return self._group
 
+    @property
+    def slice (self):
+        return self._slice
+
+    @property
+    def is_tree_node (self):
+        return self._is_tree_node
+
+    @property
+    def fwd_expect (self):
+        return self._fwd_expect
+
+    @fwd_expect.setter
+    def fwd_expect (self, value):
+        self._fwd_expect = value
+
+    @property
+    def bkp_expect (self):
+        return self._bkp_expect
+
+    @bkp_expect.setter
+    def bkp_expect (self, value):
+        self._bkp_expect = value
+
+    @property
+    def ldst_expect (self):
+        return self._ldst_expect
+
+    @ldst_expect.setter
+    def ldst_expect (self, value):
+        self._ldst_expect = value
+
     @property
     def fwd_link (self):
         return self._fwd_link
@@ -130,6 +209,10 @@ class SumVertex(
     def lds_link (self):
         return self._lds_link
 
+    @property
+    def ldr_link (self):
+        return self._ldr_link
+
     @property
     def fds_link (self):
         return self._fds_link
@@ -147,19 +230,21 @@ class SumVertex(
               scoreboard_t ldsa_expect;
               scoreboard_t ldst_expect;
               uchar        is_first_group;
+              uchar        is_tree_node;
             } s_conf_t;
 
             pack: standard sizes, little-endian byte order,
             explicit padding
         """
 
-        return struct.pack ("<5IB3x",
-                            self.group.units,
+        return struct.pack ("<5I2B2x",
+                            self._units,
                             self._fwd_expect,
                             self._bkp_expect,
                             self._ldsa_expect,
                             self._ldst_expect,
-                            self._is_first_group
+                            self._is_first_group,
+                            self._is_tree_node
                             )
 
     @property
@@ -184,6 +269,16 @@ class SumVertex(
         # Generate the system data region for simulation.c requirements
         generate_steps_system_data_region(spec, MLPRegions.SYSTEM.value, self)
 
+        # write the application data regions
+        self.write_data_regions (spec, routing_info)
+
+        spec.end_specification ()
+
+
+    def write_data_regions (self, spec, routing_info):
+        """ writes the application SDRAM regions into spec
+            (used for both SpiNNaker and host runs)
+        """
         # Reserve and write the network configuration region
         spec.reserve_memory_region (MLPRegions.NETWORK.value,
                                     self._N_NETWORK_CONFIGURATION_BYTES)
@@ -225,6 +320,18 @@ class SumVertex(
             for c in ex:
                 spec.write_value (c, data_type = DataType.UINT8)
 
+        # Reserve and write the events region (if required)
+        if self._N_EVENTS_BYTES != 0:
+            spec.reserve_memory_region (MLPRegions.EVENTS.value,
+                                        self._N_EVENTS_BYTES)
+
+            spec.switch_write_focus (MLPRegions.EVENTS.value)
+
+            # write the event configurations into spec
+            for ev in self._ev_cfg:
+                for c in ev:
+                    spec.write_value (c, data_type = DataType.UINT8)
+
         # Reserve and write the routing region
         spec.reserve_memory_region (MLPRegions.ROUTING.value,
                                     self._N_KEYS_BYTES)
@@ -239,16 +346,32 @@ class SumVertex(
         spec.write_value (routing_info.get_first_key_from_pre_vertex (
             self, self.bkp_link), data_type = DataType.UINT32)
 
-        # write link keys: fds
-        spec.write_value (routing_info.get_first_key_from_pre_vertex (
-            self, self.fds_link), data_type = DataType.UINT32)
+        # write link keys: fds (tree nodes have no fds or lds links)
+        if self._is_tree_node:
+            spec.write_value (0, data_type = DataType.UINT32)
+        else:
+            spec.write_value (routing_info.get_first_key_from_pre_vertex (
+                self, self.fds_link), data_type = DataType.UINT32)
 
         # write link keys: stp (padding)
         spec.write_value (0, data_type = DataType.UINT32)
 
-        # write link keys: lds
-        spec.write_value (routing_info.get_first_key_from_pre_vertex (
-            self, self.lds_link), data_type = DataType.UINT32)
+        # write link keys: lds (the root of the lds tree has no lds link)
+        if self._is_tree_node or self._is_first_group:
+            spec.write_value (0, data_type = DataType.UINT32)
+        else:
+            spec.write_value (routing_info.get_first_key_from_pre_vertex (
+                self, self.lds_link), data_type = DataType.UINT32)
+
+        # write link keys: tck (padding)
+        spec.write_value (0, data_type = DataType.UINT32)
+
+        # write link keys: ldr
+        if self._is_tree_node:
+            spec.write_value (0, data_type = DataType.UINT32)
+        else:
+            spec.write_value (routing_info.get_first_key_from_pre_vertex (
+                self, self.ldr_link), data_type = DataType.UINT32)
 
         # Reserve and write the stage configuration region
         spec.reserve_memory_region (MLPRegions.STAGE.value,
@@ -260,8 +383,6 @@ class SumVertex(
         for c in self._network.stage_config:
             spec.write_value (c, data_type = DataType.UINT8)
 
-        spec.end_specification ()
-
 
     @overrides(AbstractRewritesDataSpecification.regenerate_data_specification)
     def regenerate_data_specification(self, spec, placement):
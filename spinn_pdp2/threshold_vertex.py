@@ -43,11 +43,13 @@ class ThresholdVertex(
 
     """ A vertex to implement a PDP2 threshold core
         that applies unit output and activation functions
+        to one slice of a group
     """
 
     def __init__(self,
                  network,
-                 group
+                 group,
+                 slc = 0
                  ):
 
         # place OUTPUT groups "close" to the host
@@ -56,8 +58,14 @@ class ThresholdVertex(
         else:
             constraints = None
 
+        # slices of split groups are labelled with their index
+        if group.slices > 1:
+            _label = f"t_core{group.id}_{slc}"
+        else:
+            _label = f"t_core{group.id}"
+
         super(ThresholdVertex, self).__init__(
-            label = "t_core{}".format (group.id),
+            label = _label,
             binary_name = "threshold.aplx",
             constraints = constraints)
 
@@ -66,6 +74,9 @@ class ThresholdVertex(
         # application-level data
         self._network = network
         self._group   = group
+        self._slice   = slc
+        self._units   = group.slice_units (slc)
+        self._parts   = group.slice_partitions (slc)
         self._set_cfg = network._ex_set.set_config
         self._ex_cfg  = network._ex_set.example_config
         self._ev_cfg  = network._ex_set.event_config
@@ -88,18 +99,44 @@ class ThresholdVertex(
         else:
             self._trn_group_criterion = MLPConstants.DEF_GRP_CRIT
 
-        # check if last output group in daisy chain
-        if self.group == network.output_chain[-1]:
+        # the slices of every OUTPUT group form the criterion tree
+        # (the mapper sets the criteria expected from the children and
+        # chains the slices of split groups with a max criterion),
+        # check if first or last (the root) element in the chain
+        self._crit_expect = 0
+        self._crit_max_part = 0
+
+        if self.group.is_first_out and slc == 0:
+            self._is_first_out = 1
+        else:
+            self._is_first_out = 0
+
+        if self.group == network.output_chain[-1] and \
+                slc == (self.group.slices - 1):
             self._is_last_output_group = 1
         else:
             self._is_last_output_group = 0
 
-        # forward, backprop and stop link partition names
+        # threshold-only groups receive the errors directly from the
+        # weight cores of the groups they feed, other groups receive
+        # one error per unit from their sum core
+        if network.threshold_only (self.group):
+            self._threshold_only = 1
+            self._bkp_expect = self._units * \
+                sum (g.partitions for g in network.groups
+                     if self.group in network.w_from_groups (g))
+        else:
+            self._threshold_only = 0
+            self._bkp_expect = self._units
+
+        # forward, backprop, stop and tick stop link partition names
         self._fwd_link = []
-        for p in range (self._group.partitions):
-            self._fwd_link.append ("fwd_t{}_{}".format (self.group.id, p))
+        for p in range (self._parts):
+            self._fwd_link.append ("fwd_t{}_{}".format (self.group.id,
+                slc * self.group.slice_parts + p))
         self._bkp_link = "bkp_t{}".format (self.group.id)
         self._stp_link = "stp_t{}".format (self.group.id)
+        self._tck_link = "tck_t{}".format (self.group.id)
 
         # reserve key space for every link
         self._n_keys = MLPConstants.KEY_SPACE_SIZE
@@ -130,16 +167,18 @@ class ThresholdVertex(
 
         # list of group inputs (empty if not an INPUT group)
         self._N_INPUTS_BYTES = \
-            len (self._group.inputs) * _data_int.size
+            len (self._group.inputs) // self._group.units * \
+            self._units * _data_int.size
 
         # list of group targets (empty if not an OUTPUT group)
         self._N_TARGETS_BYTES = \
-            len (self._group.targets) * _data_int.size
+            len (self._group.targets) // self._group.units * \
+            self._units * _data_int.size
 
         # keys are integers
         # t cores require a different key for every group partition
         self._N_KEYS_BYTES =  _data_int.size * \
-            (MLPConstants.NUM_KEYS_REQ + self._group.partitions)
+            (MLPConstants.NUM_KEYS_REQ + self._parts)
 
         # stage configuration structure
         self._N_STAGE_CONFIGURATION_BYTES = \
@@ -147,16 +186,16 @@ class ThresholdVertex(
 
         # reserve SDRAM space used to store historic data
         self._TARGET_HISTORY_BYTES = (MLPConstants.ACTIV_SIZE // 8) * \
-            self.group.units * self.network.global_max_ticks
+            self._units * self.network.global_max_ticks
 
         self._OUT_DERIV_HISTORY_BYTES = (MLPConstants.LONG_DERIV_SIZE // 8) * \
-            self.group.units * self.network.global_max_ticks
+            self._units * self.network.global_max_ticks
 
         self._NET_HISTORY_BYTES = (MLPConstants.NET_SIZE // 8) * \
-            self.group.units * self.network.global_max_ticks
+            self._units * self.network.global_max_ticks
 
         self._OUTPUT_HISTORY_BYTES = (MLPConstants.ACTIV_SIZE // 8) * \
-            self.group.units * self.network.global_max_ticks
+            self._units * self.network.global_max_ticks
 
         # recording info region size
         if self.group.output_grp:
@@ -165,7 +204,7 @@ class ThresholdVertex(
                 len(MLPConstSizeRecordings)
 
             # first output group has extra recording channels
-            if self.group.is_first_out:
+            if self._is_first_out:
                 # number of extra recording channels
                 NUM_REC_CHANNS += len(MLPExtraRecordings)
 
@@ -178,7 +217,7 @@ class ThresholdVertex(
         if self.group.output_grp:
             # list of variable-size recording channel sizes
             self.VAR_CHANNEL_SIZES = [
-                self.group.units * (BYTES_PER_WORD // 2)  # OUTPUTS
+                self._units * (BYTES_PER_WORD // 2)  # OUTPUTS
                 ]
 
             # list of constant-size recording channel sizes
@@ -187,7 +226,7 @@ class ThresholdVertex(
                 ]
 
             # list of extra recording channel sizes
-            if self.group.is_first_out:
+            if self._is_first_out:
                 # list of extra recording channel sizes
                 self.EXTRA_CHANNEL_SIZES = [
                     4 * BYTES_PER_WORD  # TICK_DATA
@@ -236,6 +275,10 @@ class ThresholdVertex(
     def group (self):
         return self._group
 
+    @property
+    def slice (self):
+        return self._slice
+
     @property
     def fwd_link (self):
         return self._fwd_link
@@ -248,6 +291,26 @@ class ThresholdVertex(
     def stp_link (self):
         return self._stp_link
 
+    @property
+    def tck_link (self):
+        return self._tck_link
+
+    @property
+    def crit_expect (self):
+        return self._crit_expect
+
+    @crit_expect.setter
+    def crit_expect (self, value):
+        self._crit_expect = value
+
+    @property
+    def crit_max_part (self):
+        return self._crit_max_part
+
+    @crit_max_part.setter
+    def crit_max_part (self, value):
+        self._crit_max_part = value
+
     @property
     def config (self):
         """ returns a packed string that corresponds to
@@ -259,6 +322,7 @@ class ThresholdVertex(
               uchar         input_grp;
               uint          num_units;
               uint          partitions;
+              uint          blk_units;
               uchar         write_results;
               uchar         write_out;
               uchar         last_tick_only;
@@ -276,6 +340,10 @@ class ThresholdVertex(
               uchar         is_first_output_group;
               uchar         is_last_output_group;
               uchar         error_function;
+              uchar         threshold_only;
+              uchar         crit_max_part;
+              scoreboard_t  bkp_expected;
+              scoreboard_t  crit_expected;
             } t_conf_t;
 
             pack: standard sizes, little-endian byte order,
@@ -308,11 +376,12 @@ class ThresholdVertex(
         trn_group_criterion = int (self._trn_group_criterion *\
                                 (1 << MLPConstants.ERROR_SHIFT))
 
-        return struct.pack ("<2B2x2I3BxI2B2xi6I4i4B",
+        return struct.pack ("<2B2x3I3BxI2B2xi6I4i6B2x2I",
                             self.group.output_grp,
                             self.group.input_grp,
-                            self.group.units,
-                            self.group.partitions,
+                            self._units,
+                            self._parts,
+                            self.group.blk_units,
                             self.network.rec_test_results,
                             write_out,
                             last_tick_only,
@@ -331,9 +400,13 @@ class ThresholdVertex(
                             tst_group_criterion,
                             trn_group_criterion,
                             self.group.criterion_function.value,
-                            self.group.is_first_out,
+                            self._is_first_out,
                             self._is_last_output_group,
-                            self.group.error_function.value
+                            self.group.error_function.value,
+                            self._threshold_only,
+                            self._crit_max_part,
+                            self._bkp_expect,
+                            self._crit_expect
                             )
 
     @property
@@ -385,6 +458,16 @@ class ThresholdVertex(
         # Generate the system data region for simulation.c requirements
         generate_steps_system_data_region(spec, MLPRegions.SYSTEM.value, self)
 
+        # write the application data regions
+        self.write_data_regions (spec, routing_info, data_n_steps)
+
+        spec.end_specification ()
+
+
+    def write_data_regions (self, spec, routing_info, data_n_steps):
+        """ writes the application SDRAM regions into spec
+            (used for both SpiNNaker and host runs)
+        """
         # reserve and write the network configuration region
         spec.reserve_memory_region (MLPRegions.NETWORK.value,
                                     self._N_NETWORK_CONFIGURATION_BYTES)
@@ -445,7 +528,8 @@ class ThresholdVertex(
             spec.switch_write_focus (MLPRegions.INPUTS.value)
 
             # write inputs to spec
-            for _i in self._group.inputs:
+            for _i in self.group.slice_data (self.group.inputs,
+                                             self._slice):
                 # inputs are MLP fixed-point activation_t
                 if (_i is None) or (_i == float ('nan')):
                     _inp = MLPConstants.ACTIV_NaN
@@ -461,7 +545,8 @@ class ThresholdVertex(
             spec.switch_write_focus (MLPRegions.TARGETS.value)
 
             # write targets to spec
-            for _t in self._group.targets:
+            for _t in self.group.slice_data (self.group.targets,
+                                             self._slice):
                 # targets are MLP fixed-point activation_t
                 if (_t is None) or (_t == float ('nan')):
                     _tgt = MLPConstants.ACTIV_NaN
@@ -496,8 +581,19 @@ class ThresholdVertex(
         # write link keys: lds (padding)
         spec.write_value (0, data_type = DataType.UINT32)
 
+        # write link keys: tck
+        # tick stop key with fixed event durations only
+        if self._is_last_output_group and self.network.fixed_ticks:
+            spec.write_value (routing_info.get_first_key_from_pre_vertex (
+                self, self.tck_link), data_type = DataType.UINT32)
+        else:
+            spec.write_value (0, data_type = DataType.UINT32)
+
+        # write link keys: ldr (padding)
+        spec.write_value (0, data_type = DataType.UINT32)
+
         # write link keys: fwdt
-        for p in range (self.group.partitions):
+        for p in range (self._parts):
             spec.write_value (routing_info.get_first_key_from_pre_vertex (
                 self, self.fwd_link[p]), data_type = DataType.UINT32)
 
@@ -521,7 +617,7 @@ class ThresholdVertex(
             # write the actual recording channel sizes for a stage
             _sizes = [data_n_steps * sz for sz in self.VAR_CHANNEL_SIZES]
             _sizes.extend([sz for sz in self.CONST_CHANNEL_SIZES])
-            if self.group.is_first_out:
+            if self._is_first_out:
                 _sizes.extend(
                     [data_n_steps * sz for sz in self.EXTRA_CHANNEL_SIZES]
                     )
@@ -531,8 +627,6 @@ class ThresholdVertex(
                 recording_utilities.get_recording_header_array(_sizes)
             )
 
-        spec.end_specification ()
-
 
     @overrides(AbstractRewritesDataSpecification.regenerate_data_specification)
     def regenerate_data_specification(self, spec, placement):
@@ -570,7 +664,7 @@ class ThresholdVertex(
             ids.extend([ch.value for ch in MLPConstSizeRecordings])
 
             # first output group has additional recording channels
-            if self.group.is_first_out:
+            if self._is_first_out:
                 ids.extend([ch.value for ch in MLPExtraRecordings])
 
             return ids
@@ -21,7 +21,7 @@ from spinnaker_graph_front_end.utilities import SimulatorVertex
 from spinnaker_graph_front_end.utilities.data_utils \
     import generate_steps_system_data_region
 
-from spinn_pdp2.mlp_types import MLPRegions, MLPConstants
+from spinn_pdp2.mlp_types import MLPRegions, MLPConstants, MLPWeightFormats
 
 
 class WeightVertex(
@@ -59,24 +59,33 @@ class WeightVertex(
         self._set_cfg    = network._ex_set.set_config
         self._ex_cfg     = network._ex_set.example_config
 
-        # compute number of rows and columns
-        if self._row_blk != (self.from_group.partitions - 1):
-            self._num_rows = MLPConstants.MAX_BLK_UNITS
-        else:
-            _r = self.from_group.units % MLPConstants.MAX_BLK_UNITS
-            if _r == 0:
-                self._num_rows = MLPConstants.MAX_BLK_UNITS
-            else:
-                self._num_rows = _r
-
-        if self._col_blk != (self.group.partitions - 1):
-            self._num_cols = MLPConstants.MAX_BLK_UNITS
-        else:
-            _r = self.group.units % MLPConstants.MAX_BLK_UNITS
-            if _r == 0:
-                self._num_cols = MLPConstants.MAX_BLK_UNITS
-            else:
-                self._num_cols = _r
+        # slices that contain this core's rows and columns
+        self._row_slice = self.from_group.slice_of (self._row_blk)
+        self._col_slice = self.group.slice_of (self._col_blk)
+
+        # compute first row and column and number of rows and columns
+        # (the last block of a group may be smaller than the others)
+        _row_first = self._row_blk * self.from_group.blk_units
+        self._num_rows = min (self.from_group.blk_units,
+                              self.from_group.units - _row_first)
+
+        _col_first = self._col_blk * self.group.blk_units
+        self._num_cols = min (self.group.blk_units,
+                              self.group.units - _col_first)
+
+        # packet keys carry unit indices within a slice
+        self._row_base = _row_first - \
+            self.from_group.slice_base (self._row_slice)
+        self._col_base = _col_first - \
+            self.group.slice_base (self._col_slice)
+
+        # the first weight core of every column block of a group with
+        # a bias link also holds the bias weights (no Bias group cores)
+        self._bias_en = int (
+            network.bias_group in self.group.links_from
+            and self._row_blk == 0
+            and self.from_group == network.w_from_groups (self.group)[0]
+            )
 
         # forward, backprop and link delta summation link partition names
         self._fwd_link = "fwd_w{}_{}".format (self.group.id,
@@ -90,7 +99,7 @@ class WeightVertex(
         self._n_keys = MLPConstants.KEY_SPACE_SIZE
 
         # choose weight core-specific parameters
-        if len (self.group.weights[self.from_group]):
+        if len (self.group.weights[self.from_group]) or self._bias_en:
             if self.group.learning_rate is not None:
                 self.learning_rate = self.group.learning_rate
             elif network._learning_rate is not None:
@@ -119,6 +128,13 @@ class WeightVertex(
         # weight update function
         self.update_function = network._update_function
 
+        # weight storage format
+        self.weight_format = network._weight_format
+        if self.weight_format == MLPWeightFormats.WEIGHT_16:
+            self._wt_data_type = DataType.INT16
+        else:
+            self._wt_data_type = DataType.INT32
+
         # configuration and data files
         # find out the size of an integer!
         _data_int = DataType.INT32
@@ -139,9 +155,12 @@ class WeightVertex(
         self._N_EXAMPLES_BYTES = \
             len (self._ex_cfg) * len (self._ex_cfg[0])
 
-        # each weight is an integer
+        # bias weights are an extra row, 16-bit weights are padded
+        # to a whole number of words (the block is loaded by DMA)
+        self._N_WEIGHTS = self._num_rows * self._num_cols \
+            + self._bias_en * self._num_cols
         self._N_WEIGHTS_BYTES = \
-            self.group.units * self.from_group.units * _data_int.size
+            (self._N_WEIGHTS * self._wt_data_type.size + 3) & ~3
 
         # keys are integers
         self._N_KEYS_BYTES = MLPConstants.NUM_KEYS_REQ * _data_int.size
@@ -169,25 +188,37 @@ class WeightVertex(
                               wt_float
                               ):
         """ casts a float into an MLP fixed-point weight_t
+            (or short_weight_t if the network stores 16-bit weights)
         """
+        if self.weight_format == MLPWeightFormats.WEIGHT_16:
+            _eps   = MLPConstants.SWF_EPS
+            _max   = MLPConstants.SWF_MAX
+            _min   = MLPConstants.SWF_MIN
+            _shift = MLPConstants.SHORT_WEIGHT_SHIFT
+        else:
+            _eps   = MLPConstants.WF_EPS
+            _max   = MLPConstants.WF_MAX
+            _min   = MLPConstants.WF_MIN
+            _shift = MLPConstants.WEIGHT_SHIFT
+
         # round weight
         if wt_float >= 0:
-            wt_float = wt_float + MLPConstants.WF_EPS / 2.0
+            wt_float = wt_float + _eps / 2.0
         else:
-            wt_float = wt_float - MLPConstants.WF_EPS / 2.0
+            wt_float = wt_float - _eps / 2.0
 
         # saturate weight
-        if wt_float >= MLPConstants.WF_MAX:
-            wtemp = MLPConstants.WF_MAX;
-            print (f"warning: input weight >= {MLPConstants.WF_MAX}")
-        elif wt_float <= MLPConstants.WF_MIN:
-            wtemp = MLPConstants.WF_MIN;
-            print (f"warning: input weight <= {MLPConstants.WF_MIN}")
+        if wt_float >= _max:
+            wtemp = _max;
+            print (f"warning: input weight >= {_max}")
+        elif wt_float <= _min:
+            wtemp = _min;
+            print (f"warning: input weight <= {_min}")
         else:
             wtemp = wt_float
 
-        # return an MLP fixed-point weight_t
-        return (int (wtemp * (1 << MLPConstants.WEIGHT_SHIFT)))
+        # return an MLP fixed-point weight
+        return (int (wtemp * (1 << _shift)))
 
     @property
     def group (self):
@@ -201,6 +232,14 @@ class WeightVertex(
     def row_blk (self):
         return self._row_blk
 
+    @property
+    def row_slice (self):
+        return self._row_slice
+
+    @property
+    def col_slice (self):
+        return self._col_slice
+
     @property
     def col_blk (self):
         return self._col_blk
@@ -228,18 +267,25 @@ class WeightVertex(
               uint           num_cols;
               uint           row_blk;
               uint           col_blk;
+              uint           row_base;
+              uint           col_base;
               scoreboard_t   sync_expected;
               activation_t   initOutput;
               short_fpreal_t learningRate;
               short_fpreal_t weightDecay;
               short_fpreal_t momentum;
+              uchar          bias_en;
+              uchar          weight_format;
             } w_conf_t;
 
             pack: standard sizes, little-endian byte order,
             explicit padding
         """
-        # expect one sync packet from 'group' and one from 'from_group'
-        if self._group == self._from_group:
+        # expect one sync packet from the sum core of 'group' and one
+        # from that of 'from_group' (threshold-only groups have none)
+        if (self._group == self._from_group and
+                self._row_slice == self._col_slice) or \
+                self._network.threshold_only (self._from_group):
             sync_expected = 1
         else:
             sync_expected = 2
@@ -260,16 +306,20 @@ class WeightVertex(
         momentum = int (self.momentum *\
                               (1 << MLPConstants.SHORT_FPREAL_SHIFT))
 
-        return struct.pack ("<5Ii3h2x",
+        return struct.pack ("<7Ii3h2B",
                             self._num_rows,
                             self._num_cols,
                             self._row_blk,
                             self._col_blk,
+                            self._row_base,
+                            self._col_base,
                             sync_expected,
                             init_output,
                             learning_rate,
                             weight_decay,
-                            momentum
+                            momentum,
+                            self._bias_en,
+                            self.weight_format.value
                             )
 
     @property
@@ -294,6 +344,16 @@ class WeightVertex(
         # Generate the system data region for simulation.c requirements
         generate_steps_system_data_region(spec, MLPRegions.SYSTEM.value, self)
 
+        # write the application data regions
+        self.write_data_regions (spec, routing_info)
+
+        spec.end_specification ()
+
+
+    def write_data_regions (self, spec, routing_info):
+        """ writes the application SDRAM regions into spec
+            (used for both SpiNNaker and host runs)
+        """
         # Reserve and write the network configuration region
         spec.reserve_memory_region (MLPRegions.NETWORK.value,
                                     self._N_NETWORK_CONFIGURATION_BYTES)
@@ -347,17 +407,28 @@ class WeightVertex(
         _nrows = self.from_group.units
         _nr = self._num_rows
         _nc = self._num_cols
-        _rb = self._row_blk * MLPConstants.MAX_BLK_UNITS
-        _cb = self._col_blk * MLPConstants.MAX_BLK_UNITS
+        _rb = self._row_blk * self.from_group.blk_units
+        _cb = self._col_blk * self.group.blk_units
         if len (_wts):
             for _r in range (_nr):
                 for _c in range (_nc):
                     _wt = self.cast_float_to_weight (
                         _wts[(_cb + _c) * _nrows + (_rb + _r)])
-                    spec.write_value (_wt, data_type = DataType.INT32)
+                    spec.write_value (_wt, data_type = self._wt_data_type)
         else:
             for _ in range (_nr * _nc):
-                spec.write_value (0, data_type = DataType.INT32)
+                spec.write_value (0, data_type = self._wt_data_type)
+
+        # bias weights follow as an extra row
+        if self._bias_en:
+            _bwts = self.group.weights[self._network.bias_group]
+            for _c in range (_nc):
+                _wt = self.cast_float_to_weight (_bwts[_cb + _c])
+                spec.write_value (_wt, data_type = self._wt_data_type)
+
+        # pad 16-bit weights to a whole number of words
+        if (self._N_WEIGHTS * self._wt_data_type.size) % 4:
+            spec.write_value (0, data_type = DataType.INT16)
 
         # Reserve and write the routing region
         spec.reserve_memory_region (MLPRegions.ROUTING.value,
@@ -383,6 +454,12 @@ class WeightVertex(
         spec.write_value (routing_info.get_first_key_from_pre_vertex (
             self, self.lds_link), data_type = DataType.UINT32)
 
+        # write link keys: tck (padding)
+        spec.write_value (0, data_type = DataType.UINT32)
+
+        # write link keys: ldr (padding)
+        spec.write_value (0, data_type = DataType.UINT32)
+
         # Reserve and write the stage configuration region
         spec.reserve_memory_region (MLPRegions.STAGE.value,
                                     self._N_STAGE_CONFIGURATION_BYTES)
@@ -393,8 +470,6 @@ class WeightVertex(
         for c in self._network.stage_config:
             spec.write_value (c, data_type = DataType.UINT8)
 
-        spec.end_specification ()
-
 
     @overrides(AbstractRewritesDataSpecification.regenerate_data_specification)
     def regenerate_data_specification(self, spec, placement):